@@ -0,0 +1,116 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "frame_pacer.hpp"
+#include "json.hpp"
+
+// One measured trial: `iterations` runs over `particles` particles took `seconds`.
+struct BenchResult
+{
+    size_t particles = 0;
+    size_t iterations = 0;
+    double seconds = 0.0;
+
+    double ns_per_particle() const
+    {
+        const double work = static_cast<double>(particles) * static_cast<double>(iterations);
+        return work > 0.0 ? seconds * 1e9 / work : 0.0;
+    }
+};
+
+// Repeated trials of one benchmark at one particle count. samples holds the
+// compared metric of every trial, lower is better (ns_per_particle for throughput
+// benchmarks, milliseconds or a fraction for frame pacing).
+struct BenchSeries
+{
+    std::string name;
+    size_t particles = 0;
+    std::string metric = "ns_per_particle";
+    std::vector<double> samples;
+    size_t iterations = 0;           // over all trials
+    double seconds = 0.0;
+    double bytes_per_particle = 0.0; // memory held per particle by the structures the benchmark runs on
+
+    BenchSeries(std::string name, size_t particles, std::string metric = "ns_per_particle")
+        : name(std::move(name)), particles(particles), metric(std::move(metric)) {}
+
+    void add(const BenchResult& r)
+    {
+        samples.push_back(r.ns_per_particle());
+        iterations += r.iterations;
+        seconds += r.seconds;
+    }
+};
+
+struct BenchOptions
+{
+    std::vector<size_t> counts{ 1'000, 10'000, 100'000, 1'000'000, 10'000'000 };
+    size_t max_frame_particles = 1'000'000; // frame benchmarks skip larger counts
+    double min_seconds = 0.25;              // per trial
+    size_t min_iterations = 3;              // per trial
+    size_t trials = 5;                      // independent measurements per benchmark and count
+    std::string filter;                     // only benchmarks whose name contains this
+    bool frames = true;                     // run the offscreen SDL frame and pacing benchmarks
+    size_t pacing_particles = 100'000;      // scene size for the frame pacing benchmark
+    size_t pacing_frames = 120;             // paced frames per pacing trial
+    int threads = -1;                       // worker threads (-1 = worker_threads from config)
+
+    bool selected(const std::string& name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+};
+
+// Time body() until min_seconds have elapsed and at least min_iterations runs were
+// made. setup() runs untimed before every body() call.
+template <typename Setup, typename Body>
+BenchResult measure(const BenchOptions& options, size_t particles, Setup&& setup, Body&& body)
+{
+    BenchResult result{ particles };
+    uint64_t elapsed = 0;
+    const uint64_t budget = static_cast<uint64_t>(options.min_seconds * 1e9);
+    while (elapsed < budget || result.iterations < options.min_iterations)
+    {
+        setup();
+        const uint64_t start = FramePacer::now_ns();
+        body();
+        elapsed += FramePacer::now_ns() - start;
+        ++result.iterations;
+    }
+    result.seconds = static_cast<double>(elapsed) * 1e-9;
+    return result;
+}
+
+// options.trials measure() trials after one untimed warm-up run (first-touch page
+// faults and buffer growth are not measured).
+template <typename Setup, typename Body>
+BenchSeries measure_series(const BenchOptions& options, const std::string& name, size_t particles, Setup&& setup, Body&& body)
+{
+    BenchSeries series{ name, particles };
+    setup();
+    body();
+    for (size_t t = 0; t < std::max<size_t>(options.trials, 1); ++t) series.add(measure(options, particles, setup, body));
+    return series;
+}
+
+// ParticleSystem update, addParticle, cull kernel and geometry building.
+void run_core_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results);
+// update + render + present through SdlRenderBackend on SDL's offscreen video driver.
+// Returns false (and adds nothing) if the driver is unavailable.
+bool run_frame_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results);
+// State's paced frame loop on the offscreen driver (with --threads workers):
+// FramePacer p99 frame time, its overshoot past the target period and spin
+// fraction per trial.
+bool run_pacing_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results);
+
+nlohmann::json to_json(const BenchSeries& series);
+
+// Compare two reports written by particulate_bench. Prints a table and returns
+// false if any benchmark regressed by more than threshold (relative) with 95%
+// confidence, or is in the baseline but missing from the current report. The
+// comparison is also written as JSON to out_path when set.
+bool compare_reports(const std::string& base_path, const std::string& current_path, double threshold, const std::string& out_path);
+
+#endif
@@ -0,0 +1,113 @@
+#include "bench.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "config.hpp"
+#include "simd_kernels.hpp"
+
+// particulate_bench: throughput of the particle pipeline across particle counts,
+// and State's frame pacing, as repeated trials written to JSON (stdout, or --out
+// FILE). Progress goes to stderr.
+//
+//   --counts 1000,100000    particle counts to run (default 1k..10M, x10 steps)
+//   --filter NAME           only benchmarks whose name contains NAME
+//   --trials N              independent trials per benchmark and count (default 5)
+//   --min-time SECONDS      minimum measured time per trial
+//   --threads N             worker threads (default: worker_threads from config.json)
+//   --max-frame-particles N largest count for the frame benchmarks (default 1M)
+//   --pacing-particles N    scene size for the pacing benchmark (default 100k)
+//   --pacing-frames N       frames per pacing trial (default 120)
+//   --no-frames             skip the offscreen SDL frame and pacing benchmarks
+//
+// particulate_bench --compare BASE.json CURRENT.json [--threshold 0.05] [--out FILE]
+// compares two reports (e.g. from two builds) and exits with failure if any
+// benchmark is slower by more than the threshold at 95% confidence.
+namespace
+{
+    std::vector<size_t> parse_counts(const std::string& list)
+    {
+        std::vector<size_t> counts;
+        for (size_t pos = 0;;)
+        {
+            const size_t comma = list.find(',', pos);
+            counts.push_back(std::stoull(list.substr(pos, comma - pos)));
+            if (comma == std::string::npos) return counts;
+            pos = comma + 1;
+        }
+    }
+
+    void usage()
+    {
+        std::cerr << "usage: particulate_bench [--counts N,N,...] [--filter NAME] [--min-time S] [--threads N]\n"
+                     "                         [--trials N] [--max-frame-particles N] [--pacing-particles N]\n"
+                     "                         [--pacing-frames N] [--no-frames] [--out FILE]\n"
+                     "       particulate_bench --compare BASE.json CURRENT.json [--threshold F] [--out FILE]\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        BenchOptions options;
+        std::string out_path, base_path, current_path;
+        double threshold = 0.05;
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--compare") == 0 && i + 2 < argc) { base_path = argv[++i]; current_path = argv[++i]; }
+            else if (std::strcmp(argv[i], "--threshold") == 0 && has_value) threshold = std::atof(argv[++i]);
+            else if (std::strcmp(argv[i], "--counts") == 0 && has_value) options.counts = parse_counts(argv[++i]);
+            else if (std::strcmp(argv[i], "--trials") == 0 && has_value) options.trials = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--pacing-particles") == 0 && has_value) options.pacing_particles = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--pacing-frames") == 0 && has_value) options.pacing_frames = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--filter") == 0 && has_value) options.filter = argv[++i];
+            else if (std::strcmp(argv[i], "--min-time") == 0 && has_value) options.min_seconds = std::atof(argv[++i]);
+            else if (std::strcmp(argv[i], "--threads") == 0 && has_value) options.threads = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--max-frame-particles") == 0 && has_value) options.max_frame_particles = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--no-frames") == 0) options.frames = false;
+            else if (std::strcmp(argv[i], "--out") == 0 && has_value) out_path = argv[++i];
+            else { usage(); return EXIT_FAILURE; }
+        }
+
+        if (!base_path.empty()) return compare_reports(base_path, current_path, threshold, out_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+        const Config& config = Config::get_instance();
+        std::string simd_warning;
+        const SimdLevel simd = configure_simd_kernels(config.get_simd_kernel(), simd_warning);
+        if (!simd_warning.empty()) std::fprintf(stderr, "%s\n", simd_warning.c_str());
+
+        std::vector<BenchSeries> results;
+        run_core_benchmarks(options, results);
+        bool frames = options.frames && run_frame_benchmarks(options, results);
+        frames = frames && run_pacing_benchmarks(options, results);
+
+        nlohmann::json report;
+        report["context"] = {
+            { "simd", simd_level_name(simd) },
+            { "worker_threads", options.threads >= 0 ? options.threads : config.get_worker_threads() },
+            { "trials", options.trials },
+            { "min_seconds", options.min_seconds },
+            { "frames", frames },
+        };
+        report["benchmarks"] = nlohmann::json::array();
+        for (const BenchSeries& r : results) report["benchmarks"].push_back(to_json(r));
+
+        if (out_path.empty()) std::cout << report.dump(2) << std::endl;
+        else
+        {
+            std::ofstream out(out_path);
+            if (!out) throw std::runtime_error("cannot write " + out_path);
+            out << report.dump(2) << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Fatal error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
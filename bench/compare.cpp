@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "stats.hpp"
+
+namespace
+{
+    nlohmann::json load_report(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot read " + path);
+        nlohmann::json j;
+        in >> j;
+        if (!j.contains("benchmarks")) throw std::runtime_error(path + " is not a particulate_bench report");
+        return j;
+    }
+
+    // Samples of every benchmark in a report, keyed by (name, particles). Reports
+    // from single-trial runs only carry the mean.
+    std::map<std::pair<std::string, size_t>, std::vector<double>> samples_of(const nlohmann::json& report)
+    {
+        std::map<std::pair<std::string, size_t>, std::vector<double>> samples;
+        for (const auto& b : report["benchmarks"])
+        {
+            auto& s = samples[{ b["name"].get<std::string>(), b["particles"].get<size_t>() }];
+            if (b.contains("samples")) s = b["samples"].get<std::vector<double>>();
+            else if (b.contains("ns_per_particle")) s = { b["ns_per_particle"].get<double>() };
+        }
+        return samples;
+    }
+}
+
+bool compare_reports(const std::string& base_path, const std::string& current_path, double threshold, const std::string& out_path)
+{
+    const auto base = samples_of(load_report(base_path));
+    const auto current = samples_of(load_report(current_path));
+
+    nlohmann::json out = nlohmann::json::array();
+    size_t regressions = 0, missing = 0;
+    std::printf("%-16s %10s %12s %12s %9s %21s  %s\n", "benchmark", "particles", "base", "current", "change", "95% CI", "verdict");
+    for (const auto& [key, base_samples] : base)
+    {
+        // A baseline benchmark the current run did not produce (renamed, crashed or
+        // skipped) fails the comparison rather than passing unchecked
+        const auto it = current.find(key);
+        if (it == current.end())
+        {
+            ++missing;
+            std::printf("%-16s %10zu %12.4g %12s %9s %21s  MISSING\n", key.first.c_str(), key.second, summarize(base_samples).mean, "-", "", "");
+            out.push_back({ { "name", key.first }, { "particles", key.second }, { "verdict", "missing" } });
+            continue;
+        }
+        const Comparison c = compare_samples(base_samples, it->second, threshold);
+        if (c.verdict == Comparison::Verdict::Regression) ++regressions;
+
+        if (c.base.mean == 0.0) // no relative change from a zero baseline
+            std::printf("%-16s %10zu %12.4g %12.4g %9s %21s  %s\n", key.first.c_str(), key.second, c.base.mean, c.current.mean,
+                        "n/a", "", verdict_name(c.verdict));
+        else
+            std::printf("%-16s %10zu %12.4g %12.4g %+8.2f%% [%+8.2f%%, %+8.2f%%]  %s\n", key.first.c_str(), key.second, c.base.mean,
+                        c.current.mean, c.change * 100.0, c.ci_low * 100.0, c.ci_high * 100.0, verdict_name(c.verdict));
+        out.push_back({
+            { "name", key.first },
+            { "particles", key.second },
+            { "base_mean", c.base.mean },
+            { "current_mean", c.current.mean },
+            { "change", c.change },
+            { "ci95", { c.ci_low, c.ci_high } },
+            { "verdict", verdict_name(c.verdict) },
+        });
+    }
+    std::printf("%zu regression(s) beyond %.1f%% at 95%% confidence, %zu missing benchmark(s)\n", regressions, threshold * 100.0, missing);
+
+    if (!out_path.empty())
+    {
+        std::ofstream file(out_path);
+        if (!file) throw std::runtime_error("cannot write " + out_path);
+        file << nlohmann::json{ { "threshold", threshold }, { "comparisons", out } }.dump(2) << std::endl;
+    }
+    return regressions == 0 && missing == 0;
+}
@@ -0,0 +1,129 @@
+#include "bench.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include "config.hpp"
+#include "headless.hpp"
+#include "particle_system.hpp"
+#include "simd_kernels.hpp"
+#include "simple_particle.hpp"
+#include "static_particle_system.hpp"
+#include "thread_pool.hpp"
+
+namespace
+{
+    // A camera zoomed in 2x on the spawned scene, so about a quarter of it is on screen
+    ViewParams bench_view(const Config& config)
+    {
+        SimpleCamera camera;
+        camera.scale *= 2.0f;
+        return ViewParams::from_config(config, camera);
+    }
+
+    double per_particle(size_t bytes, size_t particles) { return particles ? static_cast<double>(bytes) / static_cast<double>(particles) : 0.0; }
+}
+
+void run_core_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results)
+{
+    Config& config = Config::get_instance();
+    const int threads = options.threads >= 0 ? options.threads : config.get_worker_threads();
+    ThreadPool pool(static_cast<size_t>(std::max(threads, 0)));
+    const SimParams params = SimParams::from_config(config, config.get_sim_step());
+    const ViewParams view = bench_view(config);
+
+    for (size_t n : options.counts)
+    {
+        std::fprintf(stderr, "core: %zu particles\n", n);
+        config.set_max_particles(static_cast<int>(n));
+        auto ps = std::make_unique<ParticleSystem>(&pool);
+        HeadlessRunner::spawn_scene(*ps, config, n);
+
+        if (options.selected("add_particle"))
+        {
+            // Steady-state spawning into reserved capacity: the system is emptied untimed
+            // and the spawned values are prepared up front, so only addParticle is timed
+            const ParticleStore& store = ps->bucketStore(0);
+            std::vector<SimpleParticle> spawn;
+            spawn.reserve(n);
+            for (size_t i = 0; i < store.size(); ++i)
+                spawn.emplace_back(store.x[i], store.y[i], store.vx[i], store.vy[i], store.radius[i], store.color[i], store.lifetime[i]);
+
+            BenchSeries r = measure_series(options, "add_particle", n,
+                [&] { ps->killIf([](ConstParticleSpan, size_t) { return true; }); },
+                [&] { for (const SimpleParticle& p : spawn) ps->addParticle(p); });
+            r.bytes_per_particle = per_particle(ps->memoryBytes(), n);
+            results.push_back(r);
+        }
+
+        if (options.selected("update"))
+        {
+            BenchSeries r = measure_series(options, "update", n, [] {}, [&] { ps->update(params); });
+            r.bytes_per_particle = per_particle(ps->memoryBytes(), n);
+            results.push_back(r);
+        }
+
+        if (options.selected("update_static"))
+        {
+            // The same scene in a StaticParticleSystem<SimpleParticle>: kernels called
+            // directly, single-threaded (compare with "update" at threads 1)
+            const ParticleStore& store = ps->bucketStore(0);
+            auto sps = std::make_unique<StaticParticleSystem<SimpleParticle>>();
+            for (size_t i = 0; i < store.size(); ++i)
+                sps->addParticle(SimpleParticle(store.x[i], store.y[i], store.vx[i], store.vy[i], store.radius[i], store.color[i], store.lifetime[i]));
+
+            BenchSeries r = measure_series(options, "update_static", n, [] {}, [&] { sps->update(params); });
+            r.bytes_per_particle = per_particle(sps->storeOf<SimpleParticle>().memory_bytes(), n);
+            results.push_back(r);
+        }
+
+        if (options.selected("cull"))
+        {
+            // The vectorized cull kernel alone, single-threaded over the whole store
+            const ParticleStore& store = ps->bucketStore(0);
+            std::vector<uint32_t> visible(n);
+            const CullParams cull_params = view.cull_params();
+            size_t kept = 0;
+            BenchSeries r = measure_series(options, "cull", n, [] {}, [&]
+            {
+                kept = cull(store.x.data(), store.y.data(), store.prev_x.data(), store.prev_y.data(), store.radius.data(), n,
+                            cull_params, 0, visible.data());
+            });
+            r.bytes_per_particle = per_particle(store.memory_bytes() + visible.capacity() * sizeof(uint32_t), n);
+            results.push_back(r);
+            (void)kept;
+        }
+
+        if (options.selected("build_geometry"))
+        {
+            // Cull, LOD and vertex building for every bucket, on the pool
+            BenchSeries r = measure_series(options, "build_geometry", n, [] {}, [&] { ps->buildGeometry(view); });
+            r.bytes_per_particle = per_particle(ps->memoryBytes(), n);
+            results.push_back(r);
+        }
+    }
+}
+
+nlohmann::json to_json(const BenchSeries& series)
+{
+    const SampleStats stats = summarize(series.samples);
+    nlohmann::json j = {
+        { "name", series.name },
+        { "particles", series.particles },
+        { "metric", series.metric },
+        { "trials", stats.n },
+        { "mean", stats.mean },
+        { "stddev", stats.stddev },
+        { "ci95", { stats.ci_low, stats.ci_high } },
+        { "samples", series.samples },
+    };
+    if (series.metric == "ns_per_particle")
+    {
+        j["iterations"] = series.iterations;
+        j["seconds"] = series.seconds;
+        j["ns_per_particle"] = stats.mean;
+        j["particles_per_second"] = stats.mean > 0.0 ? 1e9 / stats.mean : 0.0;
+        j["bytes_per_particle"] = series.bytes_per_particle;
+    }
+    return j;
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include "config.hpp"
+#include "headless.hpp"
+#include "particle_system.hpp"
+#include "sdl_render_backend.hpp"
+#include "thread_pool.hpp"
+
+bool run_frame_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results)
+{
+    if (!options.selected("frame")) return true;
+
+    // Offscreen driver: a real SDL renderer with no display attached
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO)) { std::fprintf(stderr, "frame: offscreen video unavailable: %s\n", SDL_GetError()); return false; }
+
+    Config& config = Config::get_instance();
+    SDL_Window* window = SDL_CreateWindow("particulate_bench", config.get_window_width(), config.get_window_height(), SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, nullptr) : nullptr;
+    if (!renderer)
+    {
+        std::fprintf(stderr, "frame: renderer creation failed: %s\n", SDL_GetError());
+        if (window) SDL_DestroyWindow(window);
+        SDL_Quit();
+        return false;
+    }
+    std::fprintf(stderr, "frame: %s renderer\n", SDL_GetRendererName(renderer));
+
+    {
+        SdlRenderBackend backend(renderer);
+        const int threads = options.threads >= 0 ? options.threads : config.get_worker_threads();
+        ThreadPool pool(static_cast<size_t>(std::max(threads, 0)));
+        const SimParams params = SimParams::from_config(config, config.get_sim_step());
+        SimpleCamera camera;
+        camera.scale *= 2.0f;
+        const ViewParams view = ViewParams::from_config(config, camera);
+
+        for (size_t n : options.counts)
+        {
+            if (n > options.max_frame_particles) continue;
+            std::fprintf(stderr, "frame: %zu particles\n", n);
+            config.set_max_particles(static_cast<int>(n));
+            auto ps = std::make_unique<ParticleSystem>(&pool);
+            HeadlessRunner::spawn_scene(*ps, config, n);
+
+            // One whole frame as State runs it (single-threaded simulation), without pacing
+            BenchSeries r = measure_series(options, "frame", n, [] {}, [&]
+            {
+                ps->update(params);
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderClear(renderer);
+                ps->render(backend, view);
+                SDL_RenderPresent(renderer);
+            });
+            r.bytes_per_particle = static_cast<double>(ps->memoryBytes()) / static_cast<double>(n);
+            results.push_back(r);
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return true;
+}
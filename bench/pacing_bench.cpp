@@ -0,0 +1,49 @@
+#include "bench.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include "config.hpp"
+#include "headless.hpp"
+#include "state.hpp"
+
+bool run_pacing_benchmarks(const BenchOptions& options, std::vector<BenchSeries>& results)
+{
+    if (!options.selected("pacing")) return true;
+
+    // The app's own frame loop (frame graph, simulation, render, FramePacer) on a
+    // window of the offscreen driver, with a spawned scene. State sizes its thread
+    // pool from the config when it is first created, so --threads goes there
+    Config& config = Config::get_instance();
+    const size_t n = options.pacing_particles;
+    config.set_max_particles(static_cast<int>(n));
+    if (options.threads >= 0) config.set_worker_threads(options.threads);
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    State* state = nullptr;
+    try { state = &State::get_instance(); }
+    catch (const std::exception& ex) { std::fprintf(stderr, "pacing: %s\n", ex.what()); return false; }
+    HeadlessRunner::spawn_scene(state->get_particle_system(), config, n);
+    const FramePacer& pacer = state->get_frame_pacer();
+    const double target_ms = pacer.target_fps() > 0.0 ? 1000.0 / pacer.target_fps() : config.get_target_frame_delta();
+    std::fprintf(stderr, "pacing: %zu particles, %zu threads, %zu frames per trial at %.3f ms\n", n,
+                 state->get_thread_pool().thread_count(), options.pacing_frames, target_ms);
+
+    // Overshoot is how far the slowest 1% of frames run past the target period (jitter,
+    // 0 when on time; compare_samples flags any reliable overshoot against such a
+    // baseline). The median sits on the target whenever pacing works, so it is not reported
+    BenchSeries overshoot{ "pacing_overshoot", n, "ms" }, p99{ "pacing_p99", n, "ms" }, spin{ "pacing_spin", n, "fraction" };
+    for (size_t f = 0; f < 10; ++f) state->run_frame(); // warm-up
+    for (size_t t = 0; t < std::max<size_t>(options.trials, 1); ++t)
+    {
+        state->get_frame_pacer().reset_stats();
+        for (size_t f = 0; f < options.pacing_frames; ++f) state->run_frame();
+        const FrameTimeStats stats = pacer.stats();
+        overshoot.samples.push_back(std::max(stats.p99_ms - target_ms, 0.0));
+        p99.samples.push_back(stats.p99_ms);
+        spin.samples.push_back(stats.spin_fraction);
+    }
+    results.push_back(overshoot);
+    results.push_back(p99);
+    results.push_back(spin);
+    return true;
+}
@@ -0,0 +1,80 @@
+#include "stats.hpp"
+#include <cmath>
+
+SampleStats summarize(const std::vector<double>& samples)
+{
+    SampleStats s;
+    s.n = samples.size();
+    if (s.n == 0) return s;
+    for (double v : samples) s.mean += v;
+    s.mean /= static_cast<double>(s.n);
+    s.ci_low = s.ci_high = s.mean;
+    if (s.n < 2) return s;
+
+    double sq = 0.0;
+    for (double v : samples) sq += (v - s.mean) * (v - s.mean);
+    s.stddev = std::sqrt(sq / static_cast<double>(s.n - 1));
+    const double half = t_critical_95(static_cast<double>(s.n - 1)) * s.stddev / std::sqrt(static_cast<double>(s.n));
+    s.ci_low = s.mean - half;
+    s.ci_high = s.mean + half;
+    return s;
+}
+
+double t_critical_95(double df)
+{
+    static constexpr double kTable[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df < 1.0) return kTable[0];
+    if (df <= 30.0) return kTable[static_cast<size_t>(df) - 1];
+    if (df <= 60.0) return 2.042;
+    if (df <= 120.0) return 2.000;
+    return 1.980;
+}
+
+Comparison compare_samples(const std::vector<double>& base, const std::vector<double>& current, double threshold)
+{
+    Comparison c;
+    c.base = summarize(base);
+    c.current = summarize(current);
+    if (c.base.n == 0 || c.current.n == 0) return c;
+    if (c.base.mean == 0.0)
+    {
+        if (c.base.n < 2 || c.current.n < 2) return c;
+        c.verdict = c.current.ci_low > 0.0 ? Comparison::Verdict::Regression : Comparison::Verdict::Unchanged;
+        return c;
+    }
+    c.change = (c.current.mean - c.base.mean) / c.base.mean;
+    c.ci_low = c.ci_high = c.change;
+    if (c.base.n < 2 || c.current.n < 2) return c;
+
+    // Welch: unequal variances, Welch-Satterthwaite degrees of freedom
+    const double vb = c.base.stddev * c.base.stddev / static_cast<double>(c.base.n);
+    const double vc = c.current.stddev * c.current.stddev / static_cast<double>(c.current.n);
+    const double se = std::sqrt(vb + vc);
+    double df = 1.0;
+    if (se > 0.0)
+        df = (vb + vc) * (vb + vc) / (vb * vb / static_cast<double>(c.base.n - 1) + vc * vc / static_cast<double>(c.current.n - 1));
+    const double half = t_critical_95(df) * se / c.base.mean;
+    c.ci_low = c.change - half;
+    c.ci_high = c.change + half;
+
+    if (c.ci_low > threshold) c.verdict = Comparison::Verdict::Regression;
+    else if (c.ci_high < -threshold) c.verdict = Comparison::Verdict::Improvement;
+    else c.verdict = Comparison::Verdict::Unchanged;
+    return c;
+}
+
+const char* verdict_name(Comparison::Verdict verdict)
+{
+    switch (verdict)
+    {
+    case Comparison::Verdict::Unchanged: return "unchanged";
+    case Comparison::Verdict::Regression: return "REGRESSION";
+    case Comparison::Verdict::Improvement: return "improvement";
+    case Comparison::Verdict::Inconclusive: return "inconclusive";
+    }
+    return "?";
+}
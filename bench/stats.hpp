@@ -0,0 +1,43 @@
+#ifndef BENCH_STATS_HPP
+#define BENCH_STATS_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Mean and 95% confidence interval of a set of trial samples (Student's t).
+struct SampleStats
+{
+    size_t n = 0;
+    double mean = 0.0;
+    double stddev = 0.0;             // sample standard deviation
+    double ci_low = 0.0, ci_high = 0.0; // equal to mean when n < 2
+};
+
+SampleStats summarize(const std::vector<double>& samples);
+
+// Two-sided 95% critical value of Student's t for df degrees of freedom
+// (rounded towards fewer degrees of freedom above 30, so intervals err wide).
+double t_critical_95(double df);
+
+// Baseline vs. current samples of a lower-is-better metric. Welch's t interval on
+// the difference of means, expressed relative to the baseline mean: a regression
+// is a slowdown whose whole interval lies above +threshold, an improvement one
+// whose interval lies below -threshold. Anything else is within noise.
+//
+// A zero baseline mean (e.g. pacing_overshoot when every frame was on time) has no
+// relative change: change and its interval stay 0 and the current samples are
+// judged on their own, as a regression when their whole interval lies above 0.
+struct Comparison
+{
+    enum class Verdict { Unchanged, Regression, Improvement, Inconclusive };
+
+    SampleStats base, current;
+    double change = 0.0;                  // (current - base) / base mean; 0 for a zero base
+    double ci_low = 0.0, ci_high = 0.0;   // 95% interval of change
+    Verdict verdict = Verdict::Inconclusive; // Inconclusive: fewer than 2 trials on a side
+};
+
+Comparison compare_samples(const std::vector<double>& base, const std::vector<double>& current, double threshold);
+const char* verdict_name(Comparison::Verdict verdict);
+
+#endif
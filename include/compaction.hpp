@@ -0,0 +1,61 @@
+#ifndef COMPACTION_HPP
+#define COMPACTION_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "particle_store.hpp"
+
+// Stream compaction for removing many particles from a ParticleStore at once while
+// keeping it dense and in order. Work is split into fixed-size chunks:
+//   1. mark    keep[i] = 1 for survivors (expire_chunk or a caller predicate)
+//   2. count   survivors per chunk                          (count_survivors)
+//   3. scan    exclusive prefix sum over chunk counts       (scan_survivors)
+//   4. scatter survivors of each chunk into scratch         (scatter_chunk)
+//   5. swap    scratch becomes the store                    (finish_compaction)
+// Phases 1, 2 and 4 touch only their own chunk, so chunks can run in parallel.
+//
+// The scratch store only holds data between phases 3 and 5, so stores compacted
+// one after another share one scratch reserved to the largest store's capacity;
+// the swap hands the store's old buffers back as scratch, so every store keeps
+// its reserved capacity.
+
+// Also the unit of parallel work for per-particle passes in ParticleSystem.
+constexpr size_t kCompactionChunk = 4096;
+
+// Marking state for compacting one store, reserved to the store's capacity up
+// front so compaction never allocates.
+struct CompactionBuffers
+{
+    std::vector<uint8_t> keep;   // 1 = survives
+    std::vector<size_t> offsets; // survivors per chunk, then exclusive prefix sums
+
+    void reserve(size_t capacity);
+};
+
+inline size_t compaction_chunks(size_t n) { return (n + kCompactionChunk - 1) / kCompactionChunk; }
+
+// Size buf.keep for a store of n particles.
+void begin_compaction(CompactionBuffers& buf, size_t n);
+
+// Advance ages by dt and mark particles whose (positive) lifetime has elapsed.
+void expire_chunk(ParticleStore& store, CompactionBuffers& buf, size_t chunk, float dt);
+
+void count_survivors(CompactionBuffers& buf, size_t chunk);
+
+// Turn per-chunk counts into output offsets and size the scratch store. Returns
+// the number of survivors.
+size_t scan_survivors(CompactionBuffers& buf, ParticleStore& scratch);
+
+void scatter_chunk(ParticleStore& store, const CompactionBuffers& buf, ParticleStore& scratch, size_t chunk);
+
+void finish_compaction(ParticleStore& store, ParticleStore& scratch);
+
+// Run phases 2-5 serially on a store whose buf.keep is already marked. Returns
+// the number of removed particles.
+size_t compact(ParticleStore& store, CompactionBuffers& buf, ParticleStore& scratch);
+
+// Advance ages and remove expired particles serially. Returns the number removed.
+size_t expire(ParticleStore& store, CompactionBuffers& buf, ParticleStore& scratch, float dt);
+
+#endif
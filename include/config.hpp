@@ -1,6 +1,7 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -50,6 +51,25 @@ private:
     float gravity_y = 0.0f;             // world gravity Y (normalized units/sec^2), +ve downwards
     float global_damping = 0.0f;        // velocity damping factor (0.0 = no damping)
     float default_particle_radius = 0.01f; // default normalized radius for particles
+    std::string simd_kernel = "auto";   // "auto", "scalar", "sse2", "avx2" or "avx512"
+    int worker_threads = 0;             // simulation threads incl. main (0 = one per hardware thread)
+    bool threaded_simulation = false;   // run the simulation on its own thread
+    int sim_rate = 60;                  // fixed simulation steps per second
+    int max_sim_steps = 5;              // cap on catch-up steps per frame
+    int vsync = 0;                      // 0 = pace with timers, 1 = vsync, -1 = adaptive vsync
+    std::string render_backend = "sdl"; // "sdl" (SDL_RenderGeometry) or "software" (CPU rasterizer)
+    std::string render_mode = "particles"; // "particles" or "density" (heatmap); H toggles at runtime
+    std::string density_weight = "count";  // heatmap weight: "count" or "speed"
+    float lod_threshold_px = 0.5f;      // particles with a smaller screen radius are merged per cell (0 = off)
+    float lod_cell_px = 2.0f;           // LOD cell size in pixels
+    std::string sprite_atlas;           // image for SpriteParticle frames ("" = none)
+    int sprite_frame_width = 0;         // atlas frame size in pixels (0 = whole image)
+    int sprite_frame_height = 0;
+    bool headless = false;              // simulate without a window or SDL video (also --headless)
+    int headless_steps = 1000;          // steps per headless run
+    int headless_particles = 0;         // particles spawned for a headless run (0 = max_particles)
+    bool profiler = false;              // record PROFILE_ZONEs from startup (P toggles at runtime)
+    std::string profiler_output = "particulate_trace.json"; // Chrome trace written on toggle-off and exit
 
 public:
     static Config& get_instance()
@@ -88,6 +108,25 @@ public:
     if (j.contains("gravity_y")) gravity_y = j["gravity_y"].get<float>();
     if (j.contains("global_damping")) global_damping = j["global_damping"].get<float>();
     if (j.contains("default_particle_radius")) default_particle_radius = j["default_particle_radius"].get<float>();
+    if (j.contains("simd_kernel")) simd_kernel = j["simd_kernel"].get<std::string>();
+    if (j.contains("worker_threads")) worker_threads = j["worker_threads"].get<int>();
+    if (j.contains("threaded_simulation")) threaded_simulation = j["threaded_simulation"].get<bool>();
+    if (j.contains("sim_rate")) sim_rate = j["sim_rate"].get<int>();
+    if (j.contains("max_sim_steps")) max_sim_steps = j["max_sim_steps"].get<int>();
+    if (j.contains("vsync")) vsync = j["vsync"].get<int>();
+    if (j.contains("render_backend")) render_backend = j["render_backend"].get<std::string>();
+    if (j.contains("render_mode")) render_mode = j["render_mode"].get<std::string>();
+    if (j.contains("density_weight")) density_weight = j["density_weight"].get<std::string>();
+    if (j.contains("lod_threshold_px")) lod_threshold_px = j["lod_threshold_px"].get<float>();
+    if (j.contains("lod_cell_px")) lod_cell_px = j["lod_cell_px"].get<float>();
+    if (j.contains("sprite_atlas")) sprite_atlas = j["sprite_atlas"].get<std::string>();
+    if (j.contains("sprite_frame_width")) sprite_frame_width = j["sprite_frame_width"].get<int>();
+    if (j.contains("sprite_frame_height")) sprite_frame_height = j["sprite_frame_height"].get<int>();
+    if (j.contains("headless")) headless = j["headless"].get<bool>();
+    if (j.contains("headless_steps")) headless_steps = j["headless_steps"].get<int>();
+    if (j.contains("headless_particles")) headless_particles = j["headless_particles"].get<int>();
+    if (j.contains("profiler")) profiler = j["profiler"].get<bool>();
+    if (j.contains("profiler_output")) profiler_output = j["profiler_output"].get<std::string>();
 
             target_frame_delta = (1000.0f / static_cast<float>(fps));
             ASSERT(target_frame_delta > 0.0f, "Invalid target frame delta");
@@ -157,10 +196,37 @@ public:
 
     // Simulation getters
     int get_max_particles() const { return max_particles; }
+    void set_max_particles(int v) { max_particles = v; }
     float get_gravity_x() const { return gravity_x; }
+    void set_gravity_x(float v) { gravity_x = v; }
     float get_gravity_y() const { return gravity_y; }
+    void set_gravity_y(float v) { gravity_y = v; }
     float get_global_damping() const { return global_damping; }
+    void set_global_damping(float v) { global_damping = v; }
     float get_default_particle_radius() const { return default_particle_radius; }
+    const std::string& get_simd_kernel() const { return simd_kernel; }
+    int get_worker_threads() const { return worker_threads; }
+    void set_worker_threads(int v) { worker_threads = v; }
+    bool is_threaded_simulation() const { return threaded_simulation; }
+    int get_sim_rate() const { return sim_rate; }
+    int get_max_sim_steps() const { return max_sim_steps; }
+    int get_vsync() const { return vsync; }
+    const std::string& get_render_backend() const { return render_backend; }
+    const std::string& get_render_mode() const { return render_mode; }
+    const std::string& get_density_weight() const { return density_weight; }
+    float get_lod_threshold_px() const { return lod_threshold_px; }
+    float get_lod_cell_px() const { return lod_cell_px; }
+    const std::string& get_sprite_atlas() const { return sprite_atlas; }
+    int get_sprite_frame_width() const { return sprite_frame_width; }
+    int get_sprite_frame_height() const { return sprite_frame_height; }
+    bool is_headless() const { return headless; }
+    void set_headless(bool v) { headless = v; }
+    int get_headless_steps() const { return headless_steps; }
+    int get_headless_particles() const { return headless_particles; }
+    bool is_profiler() const { return profiler; }
+    void set_profiler(bool v) { profiler = v; }
+    const std::string& get_profiler_output() const { return profiler_output; }
+    float get_sim_step() const { return 1.0f / static_cast<float>(std::max(sim_rate, 1)); } // seconds
 };
 
 #endif
\ No newline at end of file
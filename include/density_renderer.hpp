@@ -0,0 +1,72 @@
+#ifndef DENSITY_RENDERER_HPP
+#define DENSITY_RENDERER_HPP
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "frame_params.hpp"
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+
+// Heatmap render mode for views with far more particles than pixels. Instead of
+// drawing particles, accumulate() adds each particle's weight to the screen pixel
+// it falls on, and draw() tone-maps the resulting grid through a colormap into a
+// single texture. Cost is O(particles + pixels), independent of draw calls.
+//
+// Accumulation runs in parallel with up to kMaxSlices private grids (no atomics
+// or contention on dense clusters), fewer for small stores; draw() sums the grids
+// that were written, finds the peak and maps log(1 + v) / log(1 + peak) through a
+// 256-entry colormap. begin() only clears the grids the previous frame wrote.
+class DensityRenderer
+{
+public:
+    enum class Weight { Count, Speed }; // per particle: 1, or |velocity| in world units/sec
+
+    static constexpr size_t kMaxSlices = 4;             // bounds grid memory and clear/fold work (4 bytes per pixel per slice)
+    static constexpr size_t kSliceParticles = 1 << 16;  // particles per extra slice before another one is used
+
+    explicit DensityRenderer(ThreadPool* thread_pool = nullptr);
+    ~DensityRenderer();
+    DensityRenderer(const DensityRenderer&) = delete;
+    DensityRenderer& operator=(const DensityRenderer&) = delete;
+
+    // "count" or "speed"; anything else yields false.
+    static bool parse_weight(const std::string& name, Weight& weight);
+    static const char* weight_name(Weight weight);
+
+    void set_weight(Weight weight) { m_weight = weight; }
+    Weight weight() const { return m_weight; }
+
+    // Start a frame at the view's resolution, add stores, then draw() to fill the render target.
+    void begin(const ViewParams& view);
+    void accumulate(const ParticleStore& store);
+    void draw(SDL_Renderer* renderer);
+
+    float peak() const { return m_peak; } // largest pixel value of the last draw()
+
+    // Destroy the output texture; call before destroying the renderer it belongs to.
+    void release();
+
+private:
+    void resize(int width, int height);
+
+    ThreadPool* m_thread_pool;
+    Weight m_weight = Weight::Count;
+    ViewParams m_view;
+    int m_width = 0, m_height = 0;
+    size_t m_slices = 1;                   // private grids, one per pool thread up to kMaxSlices
+    size_t m_used = 0;                     // grids written since begin()
+    std::vector<float> m_grids;            // m_slices * width * height
+    std::vector<uint32_t> m_pixels;        // XRGB8888 output
+    std::vector<float> m_row_peaks;
+    float m_peak = 0.0f;
+    uint32_t m_colormap[256];
+
+    SDL_Texture* m_texture = nullptr;
+    SDL_Renderer* m_texture_renderer = nullptr;
+    int m_texture_width = 0, m_texture_height = 0;
+};
+
+#endif
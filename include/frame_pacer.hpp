@@ -0,0 +1,60 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Frame-time distribution over the pacer's recent history (milliseconds).
+struct FrameTimeStats
+{
+    size_t frames = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0, p90_ms = 0.0, p99_ms = 0.0, max_ms = 0.0;
+    double spin_fraction = 0.0; // share of wall time spent spinning rather than asleep or working
+};
+
+// Paces a loop to a fixed rate without burning a core. wait() sleeps in the OS
+// (clock_nanosleep on an absolute CLOCK_MONOTONIC deadline on Linux) until
+// slightly before the deadline, then spins only for the remainder. The early
+// margin is the measured timer slack: how late sleeps actually wake. It jumps up
+// on a late wake and decays slowly, so spinning stays short but the deadline is
+// rarely missed. Deadlines advance by whole periods so pacing does not drift; a
+// frame that overruns by more than a period restarts the schedule instead of
+// bursting to catch up.
+//
+// With a target of 0 wait() does not block (e.g. vsync already paces the loop in
+// SDL_RenderPresent) but frame times are still recorded.
+class FramePacer
+{
+public:
+    explicit FramePacer(double target_fps = 0.0, size_t history = 1024);
+
+    void set_target_fps(double fps);
+    double target_fps() const { return m_period_ns ? 1e9 / static_cast<double>(m_period_ns) : 0.0; }
+
+    // Wait for the next frame deadline. Returns seconds since the previous wait() returned.
+    double wait();
+
+    FrameTimeStats stats() const;
+    void reset_stats();
+    double sleep_slack_ms() const { return static_cast<double>(m_slack_ns) * 1e-6; }
+
+    static uint64_t now_ns();
+
+private:
+    void sleep_until(uint64_t deadline_ns);
+
+    uint64_t m_period_ns = 0;
+    uint64_t m_deadline_ns = 0;
+    uint64_t m_last_ns = 0;
+    uint64_t m_slack_ns;           // expected oversleep of the OS timer
+
+    std::vector<float> m_history;  // ring of recent frame times (ms)
+    size_t m_history_next = 0;
+    size_t m_history_count = 0;
+    uint64_t m_spin_ns = 0;        // spin and wall time since reset_stats()
+    uint64_t m_wall_ns = 0;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef FRAME_PARAMS_HPP
+#define FRAME_PARAMS_HPP
+
+#include "camera.hpp"
+#include "config.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+
+// Immutable per-frame simulation parameters. Built once per frame and passed by
+// const reference to every batch kernel, so kernels never touch Config and a
+// runtime parameter change applies to a whole frame at once.
+struct SimParams
+{
+    float dt = 0.0f;                           // seconds
+    float gravity_x = 0.0f, gravity_y = 0.0f;  // world units/sec^2
+    float damping = 0.0f;                      // linear velocity damping
+
+    static SimParams from_config(const Config& cfg, float dt)
+    {
+        return { dt, cfg.get_gravity_x(), cfg.get_gravity_y(), cfg.get_global_damping() };
+    }
+};
+
+// Immutable per-frame view parameters for render kernels.
+struct ViewParams
+{
+    SimpleCamera camera;
+    float width = 0.0f, height = 0.0f; // viewport in pixels
+    float alpha = 1.0f;                // blend from previous (0) to current (1) sim position
+    float lod_threshold_px = 0.0f;     // merge particles with a smaller screen radius (0 = off)
+    float lod_cell_px = 2.0f;          // merged cell size in pixels
+    bool textured = true;              // draw atlas sprites (false: flat quads, e.g. for the CPU rasterizer)
+
+    static ViewParams from_config(const Config& cfg, const SimpleCamera& cam, float alpha = 1.0f)
+    {
+        return { cam, static_cast<float>(cfg.get_window_width()), static_cast<float>(cfg.get_window_height()), alpha,
+                 cfg.get_lod_threshold_px(), cfg.get_lod_cell_px() };
+    }
+
+    // Interpolated world position; exact current position at alpha == 1
+    float lerp(float prev, float cur) const { return cur * alpha + prev * (1.0f - alpha); }
+
+    // World-space rectangle covered by the viewport, for the cull kernels
+    CullParams cull_params() const
+    {
+        const float half_w = width * 0.5f / camera.scale;
+        const float half_h = height * 0.5f / camera.scale;
+        return { camera.x - half_w, camera.x + half_w, camera.y - half_h, camera.y + half_h, alpha };
+    }
+};
+
+// Particles drawn vs. rejected by the viewport cull in the last render.
+struct CullStats
+{
+    size_t visible = 0;
+    size_t culled = 0;
+    size_t merged = 0;    // visible particles drawn through LOD cells instead of their own quad
+    size_t lod_cells = 0; // quads emitted for those cells
+};
+
+#endif
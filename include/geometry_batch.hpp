@@ -0,0 +1,57 @@
+#ifndef GEOMETRY_BATCH_HPP
+#define GEOMETRY_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "render_backend.hpp"
+#include "render_types.hpp"
+
+// Frame-persistent quad buffer submitted to a RenderBackend. Render kernels write
+// 4 vertices per quad straight into append()ed space; flush() then hands
+// everything over in one draw per kQuadsPerDraw quads instead of two renderer
+// calls per particle. The vertex buffer only ever grows, so a steady-state frame
+// does not allocate.
+//
+// Each committed quad is tagged with the shape it stands for. Backends drawing
+// through RenderBackend fill every quad; SoftwareRasterizer draws Disc quads
+// (particles) as circles inscribed in the quad.
+enum class QuadShape : uint8_t { Rect, Disc };
+
+class GeometryBatch
+{
+public:
+    static constexpr size_t kQuadsPerDraw = 16384; // 65536 vertices per draw call
+
+    // Space for up to `quads` more quads (4 vertices each). Valid until the next
+    // append()/flush(); commit() how many were actually written and their shape.
+    Vertex* append(size_t quads);
+    void commit(size_t quads, QuadShape shape = QuadShape::Rect);
+
+    // Draw every committed quad (textured when texture is set) and empty the batch.
+    void flush(RenderBackend& backend, TextureId texture = nullptr);
+    void clear() { m_quads = 0; }
+
+    size_t quads() const { return m_quads; }
+    const Vertex* vertices() const { return m_vertices.data(); } // 4 * quads()
+    const QuadShape* shapes() const { return m_shapes.data(); }  // quads()
+    size_t last_draw_calls() const { return m_draw_calls; }
+    size_t memory_bytes() const { return m_vertices.capacity() * sizeof(Vertex) + m_shapes.capacity() * sizeof(QuadShape); }
+
+    // Write the 4 corners of an axis-aligned square centered on (cx, cy), with UVs covering [0, 1]
+    static void write_quad(Vertex* v, float cx, float cy, float half, FColor color)
+    {
+        v[0] = { { cx - half, cy - half }, color, { 0.0f, 0.0f } };
+        v[1] = { { cx + half, cy - half }, color, { 1.0f, 0.0f } };
+        v[2] = { { cx + half, cy + half }, color, { 1.0f, 1.0f } };
+        v[3] = { { cx - half, cy + half }, color, { 0.0f, 1.0f } };
+    }
+
+private:
+    std::vector<Vertex> m_vertices;
+    std::vector<QuadShape> m_shapes;
+    size_t m_quads = 0;
+    size_t m_draw_calls = 0;
+};
+
+#endif
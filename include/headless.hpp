@@ -0,0 +1,47 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+#include "particle_system.hpp"
+#include "thread_pool.hpp"
+
+// Throughput of one headless run.
+struct HeadlessStats
+{
+    uint64_t steps = 0;
+    size_t particles = 0;          // live particles at the end of the run
+    uint64_t particle_updates = 0; // sum over steps of the particles each step advanced
+    double seconds = 0.0;          // wall time spent in ParticleSystem::update
+    double steps_per_second() const { return seconds > 0.0 ? static_cast<double>(steps) / seconds : 0.0; }
+    double updates_per_second() const { return seconds > 0.0 ? static_cast<double>(particle_updates) / seconds : 0.0; }
+};
+
+// Runs the simulation with no window, renderer or SDL video: the scene is spawned,
+// then ParticleSystem::update is called back to back in fixed sim_step slices
+// with no frame pacing, and throughput is printed to stdout. Selected with
+// "headless": true in config.json or --headless on the command line.
+class HeadlessRunner
+{
+public:
+    explicit HeadlessRunner(const Config& config);
+    HeadlessRunner(const HeadlessRunner&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+
+    // Simulate `steps` steps (headless_steps when 0), reporting progress about once a second.
+    HeadlessStats run(uint64_t steps = 0);
+
+    ParticleSystem& particle_system() { return m_particle_system; }
+
+    // Fill ps with count SimpleParticles scattered over the default view, with a
+    // fixed seed so runs are comparable. Returns the number actually added.
+    static size_t spawn_scene(ParticleSystem& ps, const Config& config, size_t count, uint32_t seed = 1);
+
+private:
+    const Config& m_config;
+    ThreadPool m_thread_pool;
+    ParticleSystem m_particle_system;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef LOD_AGGREGATOR_HPP
+#define LOD_AGGREGATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "frame_params.hpp"
+#include "geometry_batch.hpp"
+#include "particle_store.hpp"
+#include "thread_pool.hpp"
+
+// Zoom-dependent level of detail for batch rendering. Particles whose on-screen
+// radius is below ViewParams::lod_threshold_px are not drawn individually; they
+// are merged into screen cells of lod_cell_px pixels and each occupied cell is
+// drawn as one quad. The cell's color is the average of its particles weighted
+// by drawn area * alpha, and its opacity is their summed weighted area over the
+// cell area (clamped to 1). Render cost for small particles is thus bounded by
+// the number of screen cells rather than the particle count, while particles
+// above the threshold keep full per-particle rendering.
+//
+// filter() may run concurrently for different slices; each slice accumulates
+// into its own grid. emit() folds the slices, resets them for the next frame and
+// appends the cell quads.
+class LodAggregator
+{
+public:
+    static constexpr size_t kMaxSlices = 4; // bounds grid memory (16 bytes per cell per slice)
+
+    explicit LodAggregator(ThreadPool* thread_pool = nullptr);
+
+    // Start a frame. active() is false (and filter() must not be called) when the
+    // view disables LOD.
+    void begin(const ViewParams& view);
+    bool active() const { return m_active; }
+    size_t slices() const { return m_slices; }
+
+    // Merge the particles of `visible` below the threshold into slice's grid and
+    // compact the others to the front of `visible`, in order. Returns how many remain.
+    size_t filter(ConstParticleSpan span, uint32_t* visible, size_t count, size_t slice);
+
+    // Append one quad per occupied cell to out. Returns the number of quads.
+    size_t emit(GeometryBatch& out);
+
+    size_t merged() const; // particles merged since begin()
+
+private:
+    struct Cell
+    {
+        float r, g, b; // sum of color * weight
+        float weight;  // sum of drawn area (px^2) * alpha
+    };
+
+    ThreadPool* m_thread_pool;
+    size_t m_slices;
+    bool m_active = false;
+    ViewParams m_view;
+    float m_cell_px = 1.0f;
+    int m_cols = 0, m_rows = 0;
+    std::vector<Cell> m_grids;           // m_slices grids of m_cols * m_rows, zero between frames
+    std::vector<size_t> m_merged;        // per slice
+    std::vector<uint32_t> m_row_offsets; // occupied cells per row, then exclusive offsets
+};
+
+#endif
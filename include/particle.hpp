@@ -1,8 +1,8 @@
 #ifndef PARTICLE_HPP
 #define PARTICLE_HPP
 
-#include <SDL3/SDL.h>
 #include "camera.hpp"
+#include "render_backend.hpp"
 
 // Abstract particle base class. Concrete particles implement update() and render().
 class Particle
@@ -13,8 +13,11 @@ public:
     // Update simulation state for this particle by dt seconds.
     virtual void update(float dt) = 0;
 
-    // Render particle to the provided renderer using the camera for world->screen mapping.
-    virtual void render(SDL_Renderer* renderer, const SimpleCamera& cam) const = 0;
+    // Render particle through the backend using the camera for world->screen mapping.
+    virtual void render(RenderBackend& backend, const SimpleCamera& cam) const = 0;
+
+    // Return false once the particle should be removed from its ParticleSystem.
+    virtual bool alive() const { return true; }
 };
 
 #endif
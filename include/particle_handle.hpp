@@ -0,0 +1,35 @@
+#ifndef PARTICLE_HANDLE_HPP
+#define PARTICLE_HANDLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "particle_store.hpp"
+
+// Stable reference to a batch particle in a ParticleSystem. `index` names a slot in
+// the system's slot table and `generation` is bumped every time that slot is
+// freed, so a handle to a dead particle never resolves to whichever particle
+// later reuses the slot.
+struct ParticleHandle
+{
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != kInvalidIndex; }
+    explicit operator bool() const { return valid(); }
+    bool operator==(const ParticleHandle&) const = default;
+};
+
+// A resolved handle: the store holding the particle and its current dense index.
+// Only meaningful until the next update() or kill, which may move particles.
+struct ParticleRef
+{
+    ParticleStore* store = nullptr;
+    size_t bucket = 0;
+    size_t index = 0;
+
+    explicit operator bool() const { return store != nullptr; }
+};
+
+#endif
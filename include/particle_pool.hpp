@@ -0,0 +1,57 @@
+#ifndef PARTICLE_POOL_HPP
+#define PARTICLE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Allocation counters. A hit is a request served from memory the system already
+// owns; a miss had to go to the global heap. A steady-state frame should add no misses.
+struct AllocatorStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    AllocatorStats& operator+=(const AllocatorStats& o) { hits += o.hits; misses += o.misses; return *this; }
+};
+
+// Slab allocator for polymorphic Particle objects. Requests are rounded up to a
+// small set of size classes; each class keeps an intrusive free list fed by slabs
+// of fixed block count. Freed blocks are recycled and slabs are never returned,
+// so once the pool has grown to the peak live count no further heap calls happen.
+// Requests larger than the biggest class fall back to the global heap (a miss).
+class ParticlePool
+{
+public:
+    static constexpr size_t kMaxBlockSize = 256;
+    static constexpr size_t kBlockAlign = alignof(std::max_align_t);
+
+    // max_blocks bounds the slab size (never more blocks per slab than can be live).
+    explicit ParticlePool(size_t max_blocks);
+    ~ParticlePool() = default;
+    ParticlePool(const ParticlePool&) = delete;
+    ParticlePool& operator=(const ParticlePool&) = delete;
+
+    void* allocate(size_t size, size_t align);
+    void deallocate(void* p, size_t size, size_t align);
+
+    const AllocatorStats& stats() const { return m_stats; }
+    void reset_stats() { m_stats = {}; }
+
+private:
+    static constexpr size_t kClassCount = 4; // 32, 64, 128, 256 bytes
+
+    struct FreeBlock { FreeBlock* next; };
+
+    static size_t class_of(size_t size);
+    static size_t class_size(size_t cls) { return size_t{32} << cls; }
+    void grow(size_t cls);
+
+    size_t m_slab_blocks;
+    FreeBlock* m_free[kClassCount] = {};
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+    AllocatorStats m_stats;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef PARTICLE_STORE_HPP
+#define PARTICLE_STORE_HPP
+
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "render_types.hpp"
+
+// Mutable view over a contiguous range of a ParticleStore. Batch kernels take
+// spans so a single call can process any sub-range of a store.
+struct ParticleSpan
+{
+    float* x; float* y;
+    float* prev_x; float* prev_y;
+    float* vx; float* vy;
+    float* radius;
+    Color* color;
+    float* age; float* lifetime;
+    uint16_t* sprite;
+    size_t count;
+};
+
+// Read-only counterpart of ParticleSpan, used by render kernels.
+struct ConstParticleSpan
+{
+    const float* x; const float* y;
+    const float* prev_x; const float* prev_y;
+    const float* vx; const float* vy;
+    const float* radius;
+    const Color* color;
+    const float* age; const float* lifetime;
+    const uint16_t* sprite;
+    size_t count;
+};
+
+// Contiguous structure-of-arrays particle storage. Each attribute lives in its own
+// array so hot loops (e.g. integration) only stream the fields they touch.
+// Index i across all arrays describes one particle.
+struct ParticleStore
+{
+    std::vector<float> x, y;        // world position
+    std::vector<float> prev_x, prev_y; // position before the last step (render interpolation)
+    std::vector<float> vx, vy;      // world velocity (units/sec)
+    std::vector<float> radius;      // world radius
+    std::vector<Color> color;
+    std::vector<float> age;         // seconds since spawn
+    std::vector<float> lifetime;    // seconds; <= 0 lives until killed
+    std::vector<uint16_t> sprite;   // atlas frame (buckets bound to a SpriteAtlas)
+    std::vector<uint32_t> slot;     // owning handle slot (see ParticleHandle)
+
+    // Apply f to every column (f must accept any std::vector<T>&, const for a const store).
+    template <typename F>
+    void for_each_column(F&& f)
+    {
+        f(x); f(y); f(prev_x); f(prev_y); f(vx); f(vy); f(radius); f(color); f(age); f(lifetime); f(sprite); f(slot);
+    }
+    template <typename F>
+    void for_each_column(F&& f) const
+    {
+        f(x); f(y); f(prev_x); f(prev_y); f(vx); f(vy); f(radius); f(color); f(age); f(lifetime); f(sprite); f(slot);
+    }
+
+    // Apply f pairwise to matching columns of this store and other.
+    template <typename F>
+    void for_each_column(ParticleStore& other, F&& f)
+    {
+        f(x, other.x); f(y, other.y); f(prev_x, other.prev_x); f(prev_y, other.prev_y); f(vx, other.vx); f(vy, other.vy);
+        f(radius, other.radius); f(color, other.color);
+        f(age, other.age); f(lifetime, other.lifetime);
+        f(sprite, other.sprite); f(slot, other.slot);
+    }
+
+    size_t size() const { return x.size(); }
+    size_t capacity() const { return x.capacity(); }
+    bool empty() const { return x.empty(); }
+
+    // Bytes allocated across all columns
+    size_t memory_bytes() const
+    {
+        size_t bytes = 0;
+        for_each_column([&bytes](const auto& c) { bytes += c.capacity() * sizeof(c[0]); });
+        return bytes;
+    }
+
+    void reserve(size_t n) { for_each_column([n](auto& c) { c.reserve(n); }); }
+    void resize(size_t n) { for_each_column([n](auto& c) { c.resize(n); }); }
+    void clear() { for_each_column([](auto& c) { c.clear(); }); }
+
+    void push(float px, float py, float pvx, float pvy, float pr, Color c, float plifetime, uint32_t pslot = 0, uint16_t psprite = 0)
+    {
+        x.push_back(px); y.push_back(py);
+        prev_x.push_back(px); prev_y.push_back(py);
+        vx.push_back(pvx); vy.push_back(pvy);
+        radius.push_back(pr);
+        color.push_back(c);
+        age.push_back(0.0f);
+        lifetime.push_back(plifetime);
+        sprite.push_back(psprite);
+        slot.push_back(pslot);
+    }
+
+    // Remember positions in [begin, end) as the start of the step about to run
+    void save_previous(size_t begin, size_t end)
+    {
+        std::copy(x.begin() + begin, x.begin() + end, prev_x.begin() + begin);
+        std::copy(y.begin() + begin, y.begin() + end, prev_y.begin() + begin);
+    }
+
+    // O(1) removal: move the last particle into index i and shrink. Does not keep order.
+    void swap_remove(size_t i)
+    {
+        const size_t last = size() - 1;
+        for_each_column([i, last](auto& c) { if (i != last) c[i] = c[last]; c.pop_back(); });
+    }
+
+    ParticleSpan span(size_t begin, size_t end)
+    {
+        return { x.data() + begin, y.data() + begin, prev_x.data() + begin, prev_y.data() + begin, vx.data() + begin, vy.data() + begin,
+                 radius.data() + begin, color.data() + begin,
+                 age.data() + begin, lifetime.data() + begin, sprite.data() + begin, end - begin };
+    }
+    ParticleSpan span() { return span(0, size()); }
+
+    ConstParticleSpan span(size_t begin, size_t end) const
+    {
+        return { x.data() + begin, y.data() + begin, prev_x.data() + begin, prev_y.data() + begin, vx.data() + begin, vy.data() + begin,
+                 radius.data() + begin, color.data() + begin,
+                 age.data() + begin, lifetime.data() + begin, sprite.data() + begin, end - begin };
+    }
+    ConstParticleSpan span() const { return span(0, size()); }
+};
+
+#endif
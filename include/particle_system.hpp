@@ -1,23 +1,359 @@
 #ifndef PARTICLE_SYSTEM_HPP
 #define PARTICLE_SYSTEM_HPP
 
+#include <algorithm>
+#include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <typeindex>
+#include <type_traits>
+#include <new>
+#include <utility>
+#include "compaction.hpp"
+#include "frame_params.hpp"
+#include "geometry_batch.hpp"
+#include "lod_aggregator.hpp"
 #include "particle.hpp"
+#include "particle_handle.hpp"
+#include "particle_pool.hpp"
+#include "particle_store.hpp"
+#include "render_backend.hpp"
+#include "simple_particle.hpp"
+#include "sprite_atlas.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
 
+// Batch kernels for one particle type. Each call covers a whole span of
+// homogeneous particles, so there is one indirect call per type per frame.
+struct ParticleKernels
+{
+    void (*update)(ParticleSpan span, const SimParams& params) = nullptr;
+    void (*render)(ConstParticleSpan span, const uint32_t* visible, size_t count, Vertex* out, const ViewParams& view) = nullptr;
+};
+
+// Copy of the batch particle state render kernels read, taken after an update so
+// another thread can draw it while the simulation moves on.
+struct ParticleSnapshot
+{
+    struct Batch
+    {
+        ParticleKernels kernels;
+        const SpriteAtlas* atlas = nullptr;
+        ParticleStore store;
+    };
+
+    struct StageTiming
+    {
+        std::string name;
+        double start_ms = 0.0, duration_ms = 0.0;
+    };
+
+    std::vector<Batch> batches; // one per bucket, in registration order
+    std::vector<StageTiming> update_stages; // updateGraph() timings of the last update
+    uint64_t step = 0;          // number of updates the snapshot reflects
+    double sim_time = 0.0;      // simulated seconds at that point
+    uint64_t published_ns = 0;  // wall clock at publish (set by the publisher)
+};
+
+// Capacity is fixed at construction from Config::get_max_particles(): every batch
+// bucket reserves that many slots when its type is registered (plus one
+// compaction scratch store of that size shared by all buckets) and polymorphic
+// particles are carved from a slab pool, so spawning never reaches malloc once
+// warmed up. allocatorStats() reports hits/misses to verify this.
+//
+// Batch particles age every update and are removed once their lifetime elapses;
+// removal keeps each bucket dense (swap-and-pop for single kills, chunked stream
+// compaction for expiry and killIf()). Polymorphic particles are removed when
+// Particle::alive() returns false.
+//
+// Batch particles move as buckets are compacted, so external code refers to them
+// through generational ParticleHandles resolved in O(1) via a slot table.
+//
+// update() runs as a task graph: one "update:<type>" stage per bucket (kernel,
+// ageing, expiry marking) and a "plugins" stage for polymorphic particles run
+// concurrently, then a "compact" stage removes expired batch particles. With a
+// ThreadPool, per-particle passes inside those stages are additionally split into
+// kCompactionChunk-sized chunks that run in parallel. Stage timings of the last
+// update are available from updateGraph().
 class ParticleSystem
 {
 public:
-    ParticleSystem() = default;
+    explicit ParticleSystem(ThreadPool* thread_pool = nullptr);
     ~ParticleSystem() = default;
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // Register batch particle type T (SimpleParticle or a type derived from it) and
+    // return its bucket index. T's static update()/render() become the bucket's
+    // kernels. Registering the same type again returns the existing bucket.
+    template <typename T>
+    size_t registerType();
+
+    // Copy a batch particle into its type's contiguous bucket (registering T on
+    // first use). Returns an invalid handle if the system is full.
+    template <typename T>
+    ParticleHandle addParticle(const T& p);
+
+    // Construct a polymorphic Particle of type T in the slab pool. Returns nullptr
+    // when the system is full. The system owns the particle.
+    template <typename T, typename... Args>
+    T* emplaceParticle(Args&&... args);
+
+    // Take ownership of a heap-allocated polymorphic particle. Returns false (and
+    // destroys p) if the system is full.
+    bool addParticle(std::unique_ptr<Particle> p);
 
-    void addParticle(std::unique_ptr<Particle> p);
-    void update(float dt);
-    void render(SDL_Renderer* renderer, const SimpleCamera& cam) const;
-    size_t count() const { return m_particles.size(); }
+    // Remove particle `index` of a bucket in O(1). The last particle of the bucket
+    // takes its index.
+    void killParticle(size_t bucket, size_t index);
+    // Remove the particle behind a handle. Returns false if the handle is stale.
+    bool killParticle(ParticleHandle handle);
+
+    // Resolve a handle; the result is empty if the particle is gone.
+    ParticleRef find(ParticleHandle handle);
+    bool alive(ParticleHandle handle) const;
+    ParticleHandle handleAt(size_t bucket, size_t index) const;
+
+    // Remove every batch particle for which pred(ConstParticleSpan span, size_t i)
+    // returns true, keeping survivors in order. Returns the number removed. pred
+    // may be called concurrently from pool threads.
+    template <typename Pred>
+    size_t killIf(Pred pred);
+    template <typename Pred>
+    size_t killIf(size_t bucket, Pred pred);
+
+    size_t bucketSize(size_t bucket) const { return m_buckets[bucket].store.size(); }
+    size_t bucketCount() const { return m_buckets.size(); }
+
+    // Draw a bucket's particles as frames of atlas (selected by their sprite column,
+    // tinted by color); nullptr returns it to flat quads. Buckets sharing an atlas
+    // texture are drawn in one submission. The atlas must outlive its use here.
+    void setBucketAtlas(size_t bucket, const SpriteAtlas* atlas) { m_buckets[bucket].atlas = atlas; }
+    const ParticleStore& bucketStore(size_t bucket) const { return m_buckets[bucket].store; }
+
+    // Advance the simulation by params.dt. params is a per-frame snapshot shared by all kernels.
+    void update(const SimParams& params);
+    // Batch particles are drawn together. Each bucket is first culled against the
+    // viewport (vectorized, chunks in parallel) into a compacted visible index list;
+    // the bucket's kernel then emits quads for the visible particles only into one
+    // shared GeometryBatch, submitted to the backend in a handful of draws.
+    // Particles below the view's LOD threshold skip the kernel and are merged into
+    // screen cells instead (see LodAggregator). Buckets bound to a SpriteAtlas go
+    // to one textured batch per atlas texture, drawn after the flat batch.
+    // Polymorphic particles draw themselves afterwards and are not culled.
+    void render(RenderBackend& backend, const ViewParams& view) const;
+    const TaskGraph& updateGraph() const { return m_update_graph; }
+    const GeometryBatch& geometry() const { return m_geometry; }
+    size_t lastDrawCalls() const;
+    const CullStats& cullStats() const { return m_cull_stats; }
+
+    // The two halves of render() for other backends (e.g. SoftwareRasterizer):
+    // cull and build this frame's batch geometry (live stores or a snapshot), and
+    // draw the polymorphic particles through the backend. The returned batch
+    // is the flat one; pass a view with textured = false to get every bucket in it.
+    const GeometryBatch& buildGeometry(const ViewParams& view) const;
+    const GeometryBatch& buildGeometry(const ParticleSnapshot& snapshot, const ViewParams& view) const;
+    void renderPlugins(RenderBackend& backend, const ViewParams& view) const;
+
+    // Decoupled simulation: copy the current batch state into out (reusing its
+    // memory), and draw a snapshot instead of the live stores. Polymorphic
+    // particles have no snapshot; render(snapshot, ...) draws them live under a
+    // lock shared with their update. Other mutation (spawning, kills) must happen
+    // on the thread that calls update().
+    void snapshot(ParticleSnapshot& out) const;
+    void render(const ParticleSnapshot& snapshot, RenderBackend& backend, const ViewParams& view) const;
+    uint64_t steps() const { return m_steps; }
+    double simTime() const { return m_sim_time; }
+    size_t count() const { return m_batch_count + m_particles.size(); }
+    size_t capacity() const { return m_capacity; }
+
+    // Bytes held by batch storage (buckets, compaction scratch, slot table) and
+    // render buffers (geometry batches, visible lists). Polymorphic particles are not counted.
+    size_t memoryBytes() const;
+
+    AllocatorStats allocatorStats() const;
+    void resetAllocatorStats();
 
 private:
-    std::vector<std::unique_ptr<Particle>> m_particles;
+    // Returns a polymorphic particle to the pool it came from (or the heap when pool is null).
+    struct ParticleDeleter
+    {
+        ParticlePool* pool = nullptr;
+        size_t size = 0;
+        size_t align = 0;
+
+        void operator()(Particle* p) const
+        {
+            if (!pool) { delete p; return; }
+            p->~Particle();
+            pool->deallocate(p, size, align);
+        }
+    };
+    using PooledParticle = std::unique_ptr<Particle, ParticleDeleter>;
+
+    // Slot table entry; live slots point at (bucket, dense index), free slots chain
+    // through next_free.
+    struct Slot
+    {
+        uint32_t bucket = 0;
+        uint32_t dense = 0;
+        uint32_t generation = 0;
+        uint32_t next_free = ParticleHandle::kInvalidIndex;
+    };
+
+    struct Bucket
+    {
+        std::type_index type;
+        std::string name;
+        ParticleKernels kernels;
+        const SpriteAtlas* atlas = nullptr;
+        ParticleStore store;
+        CompactionBuffers compaction;
+
+        Bucket(std::type_index type, std::string name, ParticleKernels kernels)
+            : type(type), name(std::move(name)), kernels(kernels) {}
+    };
+
+    struct TexturedBatch
+    {
+        TextureId texture;
+        GeometryBatch geometry;
+    };
+
+    size_t findBucket(std::type_index type) const;
+    bool atCapacity() const { return count() >= m_capacity; }
+    void pushParticle(PooledParticle p);
+    size_t compactBucket(Bucket& bucket); // after compaction.keep is marked and counted
+    void buildUpdateGraph();
+    void updateBucket(Bucket& bucket);
+    void updatePlugins();
+    void emitGeometry(const ParticleKernels& kernels, const SpriteAtlas* atlas, const ParticleStore& store, const ViewParams& view) const;
+    GeometryBatch& geometryFor(const SpriteAtlas* atlas, const ViewParams& view) const;
+    void flushGeometry(RenderBackend& backend) const;
+    void finishGeometry() const;
+    uint32_t acquireSlot(uint32_t bucket, uint32_t dense);
+    void releaseSlot(uint32_t slot);
+    bool resolve(ParticleHandle handle, const Slot*& slot) const;
+
+    // Run f(chunk) for every kCompactionChunk-sized chunk of n particles, in parallel when possible.
+    template <typename F>
+    void forEachChunk(size_t n, F&& f) const;
+
+    ThreadPool* m_thread_pool;               // optional; not owned
+    size_t m_capacity;                       // max_particles at construction
+    std::vector<Bucket> m_buckets;           // one SoA store per batch type
+    ParticleStore m_compaction_scratch;      // shared by buckets, which compact one at a time
+    size_t m_batch_count = 0;                // particles across all buckets
+    std::vector<Slot> m_slots;               // handle slot table (reserved to capacity)
+    uint32_t m_free_slot = ParticleHandle::kInvalidIndex;
+    AllocatorStats m_store_stats;            // batch bucket spawns
+    ParticlePool m_pool;                     // backs emplaceParticle(); outlives m_particles
+    std::vector<PooledParticle> m_particles; // polymorphic particles
+
+    TaskGraph m_update_graph;
+    size_t m_graph_buckets = 0;              // bucket count the graph was built for
+    SimParams m_params;                      // parameters of the update in flight
+    uint64_t m_steps = 0;
+    double m_sim_time = 0.0;
+    mutable std::mutex m_plugin_mutex;       // polymorphic update vs. snapshot render
+    mutable GeometryBatch m_geometry;        // reused by every render()
+    mutable std::vector<TexturedBatch> m_textured; // one per atlas texture seen
+    mutable std::vector<uint32_t> m_visible; // cull output, chunk c at c * kCompactionChunk
+    mutable std::vector<size_t> m_visible_counts; // per chunk, then exclusive offsets
+    mutable CullStats m_cull_stats;
+    mutable LodAggregator m_lod;
 };
 
+template <typename T>
+size_t ParticleSystem::registerType()
+{
+    static_assert(std::is_base_of_v<SimpleParticle, T>, "Batch particle types must derive from SimpleParticle");
+
+    const std::type_index type(typeid(T));
+    size_t index = findBucket(type);
+    if (index != m_buckets.size()) return index;
+
+    ParticleKernels kernels;
+    kernels.update = &T::update;
+    kernels.render = &T::render;
+    m_buckets.emplace_back(type, typeid(T).name(), kernels);
+    m_buckets.back().store.reserve(m_capacity);
+    m_buckets.back().compaction.reserve(m_capacity);
+    return index;
+}
+
+template <typename T>
+ParticleHandle ParticleSystem::addParticle(const T& p)
+{
+    if (atCapacity()) return {}; // respect max_particles
+    const size_t bucket_index = registerType<T>();
+    Bucket& bucket = m_buckets[bucket_index];
+    if (bucket.store.size() < bucket.store.capacity()) ++m_store_stats.hits;
+    else ++m_store_stats.misses;
+
+    const uint32_t slot = acquireSlot(static_cast<uint32_t>(bucket_index), static_cast<uint32_t>(bucket.store.size()));
+    bucket.store.push(p.x, p.y, p.vx, p.vy, p.radius, p.color, p.lifetime, slot, p.sprite);
+    ++m_batch_count;
+    return { slot, m_slots[slot].generation };
+}
+
+template <typename Pred>
+size_t ParticleSystem::killIf(size_t bucket_index, Pred pred)
+{
+    Bucket& bucket = m_buckets[bucket_index];
+    const size_t n = bucket.store.size();
+    if (n == 0) return 0;
+
+    begin_compaction(bucket.compaction, n);
+    const ConstParticleSpan span = std::as_const(bucket.store).span();
+    uint8_t* keep = bucket.compaction.keep.data();
+    forEachChunk(n, [&](size_t chunk)
+    {
+        const size_t begin = chunk * kCompactionChunk;
+        const size_t end = std::min(begin + kCompactionChunk, n);
+        for (size_t i = begin; i < end; ++i) keep[i] = !pred(span, i);
+        count_survivors(bucket.compaction, chunk);
+    });
+    return compactBucket(bucket);
+}
+
+template <typename Pred>
+size_t ParticleSystem::killIf(Pred pred)
+{
+    size_t removed = 0;
+    for (size_t b = 0; b < m_buckets.size(); ++b) removed += killIf(b, pred);
+    return removed;
+}
+
+template <typename T, typename... Args>
+T* ParticleSystem::emplaceParticle(Args&&... args)
+{
+    static_assert(std::is_base_of_v<Particle, T>, "emplaceParticle requires a Particle implementation");
+    if (atCapacity()) return nullptr;
+
+    void* mem = m_pool.allocate(sizeof(T), alignof(T));
+    T* p = nullptr;
+    try { p = new (mem) T(std::forward<Args>(args)...); }
+    catch (...) { m_pool.deallocate(mem, sizeof(T), alignof(T)); throw; }
+
+    pushParticle(PooledParticle(p, ParticleDeleter{ &m_pool, sizeof(T), alignof(T) }));
+    return p;
+}
+
+template <typename F>
+void ParticleSystem::forEachChunk(size_t n, F&& f) const
+{
+    const size_t chunks = compaction_chunks(n);
+    if (!m_thread_pool)
+    {
+        for (size_t c = 0; c < chunks; ++c) f(c);
+        return;
+    }
+    m_thread_pool->parallel_for(chunks, 1, [&f](size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c) f(c);
+    });
+}
+
 #endif
@@ -0,0 +1,129 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Hot-path zone profiler. PROFILE_ZONE("name") times the enclosing scope; every
+// thread records its zones into its own fixed-size ring buffer (single writer, no
+// locks, oldest zones overwritten), and write_chrome_trace() exports what the
+// rings hold as Chrome trace JSON, viewable in chrome://tracing or Perfetto.
+//
+// Recording is off until set_enabled(true). A disabled zone costs one relaxed
+// atomic load and a branch; building with PARTICULATE_PROFILER=0 removes the
+// macros entirely. Zone names must outlive the profiler (string literals, or
+// intern() for names built at runtime).
+class Profiler
+{
+public:
+    static constexpr size_t kRingCapacity = size_t{1} << 16; // zones kept per thread
+
+    struct Zone
+    {
+        const char* name;
+        uint64_t start_ns, end_ns;
+    };
+
+    static Profiler& get_instance();
+
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+    static uint64_t now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Append a finished zone to the calling thread's ring.
+    void record(const char* name, uint64_t start_ns, uint64_t end_ns);
+    // Label the calling thread in exported traces. name is copied.
+    void set_thread_name(const std::string& name);
+    // Stable copy of a runtime string, for zone names.
+    const char* intern(const std::string& name);
+
+    // Write every zone currently held by the rings (safe while threads keep
+    // recording). Returns false if the file cannot be written.
+    bool write_chrome_trace(const std::string& path) const;
+    // Zones currently held, over all threads.
+    size_t zone_count() const;
+    // Drop every recorded zone.
+    void clear();
+
+private:
+    // Ring of one thread. The owner claims a slot, fills it and then publishes it;
+    // readers copy published slots and discard any that were claimed again while
+    // they copied (a seqlock over the whole ring), so export never blocks writers.
+    struct ThreadRing
+    {
+        uint32_t tid = 0;
+        std::atomic<uint64_t> claimed{0}, published{0};
+        std::atomic<uint64_t> cleared{0}; // zones below this index were dropped by clear()
+        struct Slot
+        {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<uint64_t> start_ns{0}, end_ns{0};
+        };
+        std::array<Slot, kRingCapacity> slots;
+    };
+
+    Profiler() = default;
+    static uint32_t thread_id();   // small per-thread number, assigned on first use
+    ThreadRing& ring();            // the calling thread's ring, created on its first zone
+    std::vector<Zone> snapshot(const ThreadRing& ring) const;
+
+    static inline std::atomic<bool> s_enabled{false};
+    static inline std::atomic<uint32_t> s_next_tid{1};
+    uint64_t m_epoch_ns = now_ns(); // trace timestamps are relative to this
+    mutable std::mutex m_mutex;     // rings list, thread names and interned strings (never the record path)
+    std::vector<std::unique_ptr<ThreadRing>> m_rings;
+    std::unordered_map<uint32_t, std::string> m_thread_names;
+    std::unordered_set<std::string> m_interned;
+};
+
+// Times the enclosing scope while the profiler is enabled.
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+        : m_name(Profiler::enabled() ? name : nullptr), m_start_ns(m_name ? Profiler::now_ns() : 0)
+    {}
+    ~ProfileZone()
+    {
+        if (m_name) Profiler::get_instance().record(m_name, m_start_ns, Profiler::now_ns());
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start_ns;
+};
+
+#ifndef PARTICULATE_PROFILER
+#define PARTICULATE_PROFILER 1
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PARTICULATE_PROFILER
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_THREAD(name) Profiler::get_instance().set_thread_name(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif
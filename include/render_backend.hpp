@@ -0,0 +1,24 @@
+#ifndef RENDER_BACKEND_HPP
+#define RENDER_BACKEND_HPP
+
+#include <cstddef>
+#include "render_types.hpp"
+
+// Where ParticleSystem sends finished geometry. The core only fills vertex
+// batches; a backend turns them into draw calls (SdlRenderBackend in the app),
+// so simulation code and tools built on particulate_core never link a renderer.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    // Draw `quads` quads from vertices (4 per quad, corners in order, two triangles
+    // 0-1-2 and 0-2-3), textured when texture is set. Called with at most
+    // GeometryBatch::kQuadsPerDraw quads at a time.
+    virtual void draw_quads(const Vertex* vertices, size_t quads, TextureId texture) = 0;
+
+    // Filled screen-space rectangle in pixels, for polymorphic particles.
+    virtual void fill_rect(float x, float y, float w, float h, Color color) = 0;
+};
+
+#endif
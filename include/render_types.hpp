@@ -0,0 +1,36 @@
+#ifndef RENDER_TYPES_HPP
+#define RENDER_TYPES_HPP
+
+#include <cstdint>
+
+// Plain render data shared by the simulation core and the render backends. The
+// core never includes SDL; these mirror the layouts of SDL_Color, SDL_FColor,
+// SDL_FPoint and SDL_Vertex so the SDL backend can submit them without copying
+// (it static_asserts the match).
+
+struct Color
+{
+    uint8_t r, g, b, a;
+};
+
+struct FColor
+{
+    float r, g, b, a;
+};
+
+struct FPoint
+{
+    float x, y;
+};
+
+struct Vertex
+{
+    FPoint position;
+    FColor color;
+    FPoint tex_coord;
+};
+
+// Backend-defined texture (SDL_Texture* for the SDL backend); nullptr draws flat color.
+using TextureId = void*;
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SDL_RENDER_BACKEND_HPP
+#define SDL_RENDER_BACKEND_HPP
+
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "render_backend.hpp"
+#include "sprite_atlas.hpp"
+
+// RenderBackend on an SDL_Renderer: quads go out through SDL_RenderGeometry with
+// a fixed quad index pattern built once, so submitting never allocates. Also
+// owns the textures it loads for sprite atlases.
+class SdlRenderBackend : public RenderBackend
+{
+public:
+    explicit SdlRenderBackend(SDL_Renderer* renderer);
+    ~SdlRenderBackend() override;
+    SdlRenderBackend(const SdlRenderBackend&) = delete;
+    SdlRenderBackend& operator=(const SdlRenderBackend&) = delete;
+
+    void draw_quads(const Vertex* vertices, size_t quads, TextureId texture) override;
+    void fill_rect(float x, float y, float w, float h, Color color) override;
+
+    // Load `path` with SDL_image and split it into frame_width x frame_height frames
+    // (0 = whole image). Returns nullptr (and logs why) if the image cannot be used.
+    // The texture lives until the backend is destroyed.
+    std::unique_ptr<SpriteAtlas> load_atlas(const std::string& path, int frame_width = 0, int frame_height = 0);
+
+    SDL_Renderer* renderer() const { return m_renderer; }
+
+private:
+    SDL_Renderer* m_renderer;        // not owned
+    std::vector<int> m_indices;      // two triangles per quad, GeometryBatch::kQuadsPerDraw quads
+    std::vector<SDL_Texture*> m_textures;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Integration kernel shared by batch particle types: gravity, clamped linear
+// damping and an explicit Euler step over SoA arrays. Per particle:
+//     v = (v + g * dt) * damping_factor
+//     p = p + v * dt
+// where damping_factor = max(0, 1 - damping * dt) (1 when damping <= 0).
+//
+// Tolerance: the vector paths perform the same IEEE single-precision operations
+// in the same order as the scalar path (separate mul/add, no reciprocal or FMA
+// tricks), so results are bitwise identical. simd_kernels.cpp is built with
+// -ffp-contract=off for this reason; a build that lets the compiler contract
+// mul+add into FMA (e.g. in the AVX-512 variant) may differ by at most 1 ulp
+// per component per step.
+struct IntegrateParams
+{
+    float gx_dt, gy_dt;     // gravity * dt
+    float damping_factor;   // clamped linear damping factor for this step
+    float dt;
+
+    static IntegrateParams make(float gravity_x, float gravity_y, float damping, float dt);
+};
+
+// Viewport cull: particle i is visible when its interpolated position
+//     p = cur * alpha + prev * (1 - alpha)      (as ViewParams::lerp)
+// grown by its radius overlaps the world-space rectangle [min_x, max_x] x [min_y, max_y].
+// Kernels append the indices (plus base) of visible particles to out in order and
+// return how many they wrote. out must have room for n indices.
+struct CullParams
+{
+    float min_x, max_x, min_y, max_y;
+    float alpha;
+};
+
+// Instruction set variants the hot kernels are compiled for. On x86 with GCC/Clang
+// every variant is built into the binary and the best one supported by the host
+// CPU is selected at runtime; other targets only have Scalar (and SSE2 where the
+// baseline ISA includes it).
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+const char* simd_level_name(SimdLevel level);
+// Parses "scalar", "sse2", "avx2" or "avx512"; anything else (e.g. "auto") yields false.
+bool parse_simd_level(const std::string& name, SimdLevel& level);
+
+// Highest variant both compiled in and supported by this CPU (cpuid).
+SimdLevel detect_simd_level();
+
+// Select the kernels to use: "auto" picks detect_simd_level(); a named variant is
+// used if supported, otherwise the best supported one, so a forced variant never
+// runs on a CPU without its instructions. Returns the level chosen; warning is set
+// to a message for the caller to log when the request could not be honoured (an
+// unsupported or unknown name) and cleared otherwise.
+// Until this is called the detected level is used.
+SimdLevel configure_simd_kernels(const std::string& requested, std::string& warning);
+SimdLevel active_simd_level();
+
+void integrate_scalar(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p);
+void integrate_sse2(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p);
+void integrate_avx2(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p);
+void integrate_avx512(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p);
+
+// Dispatches to the active variant.
+void integrate(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p);
+
+size_t cull_scalar(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                   size_t n, const CullParams& p, uint32_t base, uint32_t* out);
+size_t cull_sse2(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                 size_t n, const CullParams& p, uint32_t base, uint32_t* out);
+size_t cull_avx2(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                 size_t n, const CullParams& p, uint32_t base, uint32_t* out);
+size_t cull_avx512(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                   size_t n, const CullParams& p, uint32_t base, uint32_t* out);
+
+// Dispatches to the active variant.
+size_t cull(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+            size_t n, const CullParams& p, uint32_t base, uint32_t* out);
+
+#endif
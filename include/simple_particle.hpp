@@ -1,26 +1,70 @@
 #ifndef SIMPLE_PARTICLE_HPP
 #define SIMPLE_PARTICLE_HPP
 
-#include "particle.hpp"
-#include <SDL3/SDL.h>
+#include "frame_params.hpp"
+#include "geometry_batch.hpp"
+#include "particle_store.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
 
-// Simple concrete particle: moves with velocity and renders as a filled rectangle
-// (square) approximating a circle. Position and radius are in world coordinates
-// (floats, unbounded). The camera maps world->screen using pixels-per-unit.
-class SimpleParticle : public Particle
+// Simple particle: moves with velocity and renders as a filled square approximating
+// a circle. Position and radius are in world coordinates (floats,
+// unbounded). The camera maps world->screen using pixels-per-unit.
+//
+// A SimpleParticle value only describes a particle to spawn. Live particles are
+// kept in a ParticleStore owned by ParticleSystem and advanced in bulk by the
+// static update()/render() batch kernels below.
+//
+// Other batch particle types derive from SimpleParticle (sharing its spawn
+// fields and storage layout) and hide update() and/or render() with their own
+// kernels; see ParticleSystem::registerType(). The kernels are defined inline so
+// StaticParticleSystem can inline them into its per-type loops.
+struct SimpleParticle
 {
-public:
-    SimpleParticle(float x, float y, float vx, float vy, float radius_world, SDL_Color color);
-    virtual ~SimpleParticle() = default;
-
-    void update(float dt) override;
-    void render(SDL_Renderer* renderer, const SimpleCamera& cam) const override;
-
-private:
-    float m_x, m_y;
-    float m_vx, m_vy;
-    float m_radius; // normalized radius (fraction of width)
-    SDL_Color m_color;
+    SimpleParticle(float x, float y, float vx, float vy, float radius_world, Color color, float lifetime_seconds = 0.0f)
+        : x(x), y(y), vx(vx), vy(vy), radius(radius_world), color(color), lifetime(lifetime_seconds)
+    {}
+
+    float x, y;
+    float vx, vy;
+    float radius;   // world radius
+    Color color;
+    float lifetime; // seconds; <= 0 lives until killed
+    uint16_t sprite = 0; // atlas frame, used when the type's bucket is bound to a SpriteAtlas
+
+    // Advance every particle in the span by params.dt seconds: gravity (world units),
+    // clamped linear damping and an Euler step; no wrapping (infinite plane). The
+    // step itself is the SIMD-dispatched integrate(), one indirect call per span.
+    static void update(ParticleSpan span, const SimParams& params)
+    {
+        const IntegrateParams ip = IntegrateParams::make(params.gravity_x, params.gravity_y, params.damping, params.dt);
+        integrate(span.x, span.y, span.vx, span.vy, span.count, ip);
+    }
+
+    // Write one screen-space quad (4 vertices, see GeometryBatch) to out for each of
+    // the `count` span indices in `visible` (the survivors of the viewport cull).
+    static void render(ConstParticleSpan span, const uint32_t* visible, size_t count, Vertex* out, const ViewParams& view)
+    {
+        constexpr float kInv255 = 1.0f / 255.0f;
+        const SimpleCamera& cam = view.camera;
+        const float half_w = view.width * 0.5f;
+        const float half_h = view.height * 0.5f;
+
+        for (size_t k = 0; k < count; ++k)
+        {
+            const uint32_t i = visible[k];
+            // Map world -> screen. Camera (cam.x,cam.y) is centered on screen.
+            float sx = (view.lerp(span.prev_x[i], span.x[i]) - cam.x) * cam.scale + half_w;
+            float sy = (view.lerp(span.prev_y[i], span.y[i]) - cam.y) * cam.scale + half_h;
+
+            float rpx = span.radius[i] * cam.scale; // radius in pixels based on camera scale
+
+            const Color& c = span.color[i];
+            const FColor fc{ c.r * kInv255, c.g * kInv255, c.b * kInv255, c.a * kInv255 };
+            GeometryBatch::write_quad(out + k * 4, sx, sy, rpx, fc);
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,58 @@
+#ifndef SOFTWARE_RASTERIZER_HPP
+#define SOFTWARE_RASTERIZER_HPP
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "geometry_batch.hpp"
+#include "thread_pool.hpp"
+
+// CPU render backend for machines without a GPU, where SDL's software renderer
+// is slow with many small quads. Takes the quads a frame's render kernels wrote
+// into a GeometryBatch and splats each Disc quad (a particle) as an anti-aliased
+// circle and every other quad (LOD cells, sprite particles drawn untextured) as
+// an axis-aligned rectangle with area coverage, into a CPU framebuffer uploaded
+// with one SDL_UpdateTexture per frame.
+//
+// The screen is split into kTileSize square tiles. Quads are binned to the tiles
+// their shape touches (two parallel passes, count then fill, so each tile keeps
+// submission order), then tiles are rasterized in parallel into per-tile float
+// planes with SSE2 where available and packed into the framebuffer. Blending is
+// source-over onto an opaque background, in submission order, so the result
+// matches drawing the batch front to back with the SDL backend.
+class SoftwareRasterizer
+{
+public:
+    static constexpr int kTileSize = 64;
+
+    explicit SoftwareRasterizer(ThreadPool* thread_pool = nullptr);
+    ~SoftwareRasterizer();
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    // Rasterize the batch over `background` at width x height pixels and draw it to
+    // fill the render target. The batch is left untouched.
+    void draw(const GeometryBatch& batch, SDL_Renderer* renderer, int width, int height, SDL_Color background = { 0, 0, 0, 255 });
+
+    const std::vector<uint32_t>& framebuffer() const { return m_framebuffer; } // XRGB8888, width * height
+    size_t last_binned() const { return m_bins.size(); } // tile/quad pairs in the last frame
+
+private:
+    void resize(SDL_Renderer* renderer, int width, int height);
+    void bin(const GeometryBatch& batch);
+    void rasterize_tile(const GeometryBatch& batch, size_t tile, SDL_Color background);
+
+    ThreadPool* m_thread_pool;
+    SDL_Texture* m_texture = nullptr;
+    SDL_Renderer* m_texture_renderer = nullptr;
+    int m_width = 0, m_height = 0;
+    int m_tiles_x = 0, m_tiles_y = 0;
+
+    std::vector<uint32_t> m_framebuffer;
+    std::vector<uint32_t> m_chunk_counts; // [chunk][tile] counts, then write offsets
+    std::vector<uint32_t> m_tile_begin;   // tile t owns m_bins[m_tile_begin[t], m_tile_begin[t + 1])
+    std::vector<uint32_t> m_bins;         // quad indices grouped by tile
+};
+
+#endif
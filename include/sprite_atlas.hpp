@@ -0,0 +1,37 @@
+#ifndef SPRITE_ATLAS_HPP
+#define SPRITE_ATLAS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "render_types.hpp"
+
+// Texture coordinates of one atlas frame.
+struct SpriteUV
+{
+    float u0, v0, u1, v1;
+};
+
+// One texture holding a grid of equally sized sprite frames. Frames are numbered
+// row-major from the top left; a particle's `sprite` column selects its frame.
+// Binding an atlas to a ParticleSystem bucket makes that bucket draw textured
+// quads, all of them in one submission per atlas texture. The texture belongs to
+// the backend that created it (see SdlRenderBackend::load_atlas).
+class SpriteAtlas
+{
+public:
+    // Split a texture_width x texture_height texture into frame_width x frame_height
+    // frames (0 = whole texture). frames() is 0 if not even one frame fits.
+    SpriteAtlas(TextureId texture, float texture_width, float texture_height, int frame_width = 0, int frame_height = 0);
+
+    TextureId texture() const { return m_texture; }
+    size_t frames() const { return m_uvs.size(); }
+    // Out-of-range frames wrap, so any sprite value is safe to draw
+    const SpriteUV& uv(uint16_t frame) const { return m_uvs[frame < m_uvs.size() ? frame : frame % m_uvs.size()]; }
+
+private:
+    TextureId m_texture;
+    std::vector<SpriteUV> m_uvs;
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SPRITE_PARTICLE_HPP
+#define SPRITE_PARTICLE_HPP
+
+#include "simple_particle.hpp"
+
+// SimpleParticle drawn with a sprite from its bucket's SpriteAtlas (tinted by
+// color). Shares SimpleParticle's kernels; its own bucket lets it be bound to an
+// atlas without texturing every SimpleParticle.
+struct SpriteParticle : SimpleParticle
+{
+    SpriteParticle(float x, float y, float vx, float vy, float radius_world, Color color, uint16_t frame, float lifetime_seconds = 0.0f)
+        : SimpleParticle(x, y, vx, vy, radius_world, color, lifetime_seconds)
+    {
+        sprite = frame;
+    }
+};
+
+#endif
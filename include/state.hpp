@@ -2,10 +2,23 @@
 #define STATE_HPP
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 
 #include "config.hpp"
+#include "frame_pacer.hpp"
 #include "camera.hpp"
+#include "density_renderer.hpp"
 #include "particle_system.hpp"
+#include "profiler.hpp"
+#include "sdl_render_backend.hpp"
+#include "software_rasterizer.hpp"
+#include "sprite_atlas.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+#include "triple_buffer.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
 
 class State
 {
@@ -19,20 +32,53 @@ private:
 
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
+    std::unique_ptr<SdlRenderBackend> sdl_backend; // particle geometry and atlas textures go through it
 
-    Uint64 last_frame_time = 0; // SDL_GetTicksNS timestamps (nanoseconds)
+    FramePacer frame_pacer;     // paces run_frame() to the target fps (or just measures under vsync)
     float delta_time = 0.0f;    // seconds
 
+    // Fixed-step simulation: frame time accumulates and is consumed in sim_step slices
+    float sim_accumulator = 0.0f; // seconds not yet simulated
+    float render_alpha = 1.0f;    // fraction of a step between the last two sim states
+
     bool quit = false;
 
-    ParticleSystem particle_system; // Particle-based simulation
+    ThreadPool thread_pool{ static_cast<size_t>(std::max(config.get_worker_threads(), 0)) };
+    ParticleSystem particle_system{ &thread_pool }; // Particle-based simulation
     SimpleCamera camera;            // Simple camera for panning over the 2D world
+    std::unique_ptr<SoftwareRasterizer> software_rasterizer; // set when render_backend is "software"
+    std::unique_ptr<SpriteAtlas> sprite_atlas;               // bound to the SpriteParticle bucket
+    DensityRenderer density_renderer{ &thread_pool };         // heatmap mode (H toggles)
+    bool density_view = false;
+
+    // Per-frame stages: input (main thread) overlaps the simulation (pool), and
+    // render (main thread) waits for both. With threaded_simulation the simulate
+    // stage is replaced by the simulation thread and render draws its latest snapshot.
+    TaskGraph frame_graph;
+    Uint64 frame_count = 0;
+
+    // Decoupled simulation (threaded_simulation)
+    bool threaded_simulation = false;
+    std::thread simulation_thread;
+    std::atomic<bool> simulation_stop{false};
+    TripleBuffer<ParticleSnapshot> snapshots;
 
     void setup_scene();        // Internal helper to populate layers
+    void build_frame_graph();
+    void log_frame_timings();
+    void log_frame_pacing() const;
+    void simulation_loop();
+    void render_software(const GeometryBatch& geometry, const ViewParams& view);
+    void render_density(const ViewParams& view, const ParticleSnapshot* snapshot);
+    void toggle_profiler();
+    void write_profile() const;
 
 public:
     static State& get_instance();
 
+    // Run one frame through the frame graph, then pace to the target frame rate.
+    void run_frame();
+
     void render();
     void process_input();
     void update();
@@ -40,6 +86,10 @@ public:
     bool should_quit() const;
     SimpleCamera& get_camera() { return camera; }
     ParticleSystem& get_particle_system() { return particle_system; }
+    const ThreadPool& get_thread_pool() const { return thread_pool; }
+    const TaskGraph& get_frame_graph() const { return frame_graph; }
+    const FramePacer& get_frame_pacer() const { return frame_pacer; }
+    FramePacer& get_frame_pacer() { return frame_pacer; }
 };
 
 #endif
\ No newline at end of file
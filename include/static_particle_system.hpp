@@ -0,0 +1,123 @@
+#ifndef STATIC_PARTICLE_SYSTEM_HPP
+#define STATIC_PARTICLE_SYSTEM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "compaction.hpp"
+#include "config.hpp"
+#include "frame_params.hpp"
+#include "geometry_batch.hpp"
+#include "particle_store.hpp"
+#include "simple_particle.hpp"
+
+// Compile-time typed particle system for builds that know their particle types up
+// front, e.g. StaticParticleSystem<SimpleParticle, MyParticle>. Every type gets its
+// own contiguous ParticleStore and update()/render() call Ts::update/Ts::render
+// directly (no vtables, no per-type ParticleKernels pointers), so kernels defined
+// in their header, like SimpleParticle's, are inlined into the per-type loops.
+// Kernels that call the SIMD-dispatched integrate()/cull() still make one indirect
+// call per type per step. Use ParticleSystem when types are only known at runtime
+// (registered batch types or polymorphic Particle plugins).
+template <typename... Ts>
+class StaticParticleSystem
+{
+    static_assert(sizeof...(Ts) > 0, "StaticParticleSystem needs at least one particle type");
+    static_assert((std::is_base_of_v<SimpleParticle, Ts> && ...), "Batch particle types must derive from SimpleParticle");
+
+public:
+    StaticParticleSystem()
+        : m_capacity(static_cast<size_t>(std::max(Config::get_instance().get_max_particles(), 0)))
+    {
+        for (auto& store : m_stores) store.reserve(m_capacity);
+        for (auto& buf : m_compaction) buf.reserve(m_capacity);
+        m_scratch.reserve(m_capacity);
+    }
+    ~StaticParticleSystem() = default;
+
+    // Returns false if the system is full.
+    template <typename T>
+    bool addParticle(const T& p)
+    {
+        if (count() >= m_capacity) return false; // respect max_particles
+        storeOf<T>().push(p.x, p.y, p.vx, p.vy, p.radius, p.color, p.lifetime, 0, p.sprite);
+        return true;
+    }
+
+    void update(const SimParams& params) { (updateType<Ts>(params), ...); }
+    void render(RenderBackend& backend, const ViewParams& view) const
+    {
+        m_cull_stats = {};
+        (renderType<Ts>(view), ...);
+        m_geometry.flush(backend);
+    }
+    const CullStats& cullStats() const { return m_cull_stats; }
+
+    size_t count() const
+    {
+        size_t n = 0;
+        for (const auto& store : m_stores) n += store.size();
+        return n;
+    }
+
+    template <typename T>
+    ParticleStore& storeOf()
+    {
+        static_assert(indexOf<T>() < sizeof...(Ts), "Type is not part of this StaticParticleSystem");
+        return m_stores[indexOf<T>()];
+    }
+
+    template <typename T>
+    const ParticleStore& storeOf() const
+    {
+        static_assert(indexOf<T>() < sizeof...(Ts), "Type is not part of this StaticParticleSystem");
+        return m_stores[indexOf<T>()];
+    }
+
+private:
+    template <typename T>
+    static constexpr size_t indexOf()
+    {
+        constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+        for (size_t i = 0; i < sizeof...(Ts); ++i) if (matches[i]) return i;
+        return sizeof...(Ts);
+    }
+
+    template <typename T>
+    void updateType(const SimParams& params)
+    {
+        ParticleStore& store = storeOf<T>();
+        if (store.empty()) return;
+        store.save_previous(0, store.size());
+        T::update(store.span(), params);
+        expire(store, m_compaction[indexOf<T>()], m_scratch, params.dt);
+    }
+
+    template <typename T>
+    void renderType(const ViewParams& view) const
+    {
+        const ParticleStore& store = storeOf<T>();
+        const size_t n = store.size();
+        if (n == 0) return;
+        if (m_visible.size() < n) m_visible.resize(n);
+        const size_t visible = cull(store.x.data(), store.y.data(), store.prev_x.data(), store.prev_y.data(),
+                                    store.radius.data(), n, view.cull_params(), 0, m_visible.data());
+        m_cull_stats.visible += visible;
+        m_cull_stats.culled += n - visible;
+        if (visible == 0) return;
+        T::render(store.span(), m_visible.data(), visible, m_geometry.append(visible), view);
+        m_geometry.commit(visible, QuadShape::Disc);
+    }
+
+    size_t m_capacity;
+    std::array<ParticleStore, sizeof...(Ts)> m_stores;
+    std::array<CompactionBuffers, sizeof...(Ts)> m_compaction;
+    ParticleStore m_scratch; // shared, types are compacted one after another
+    mutable GeometryBatch m_geometry;
+    mutable std::vector<uint32_t> m_visible;
+    mutable CullStats m_cull_stats;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "thread_pool.hpp"
+
+// Frame task graph: named stages with declared dependencies, built once and run
+// every frame on a ThreadPool. A stage is scheduled as soon as all of its
+// dependencies finish, so independent stages overlap and a frame costs its
+// critical path rather than the sum of its stages. Stages with Affinity::Caller
+// run on the thread that calls run() (needed for SDL event and render calls);
+// all others run on pool threads. Start time and duration of every stage are
+// recorded for the last run, and every stage is a profiler zone.
+class TaskGraph
+{
+public:
+    using StageId = size_t;
+    enum class Affinity { Any, Caller };
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // Dependencies must be stages added earlier, so insertion order is a valid serial order.
+    StageId add(std::string name, std::function<void()> fn, std::vector<StageId> deps = {}, Affinity affinity = Affinity::Any);
+    void clear() { m_stages.clear(); }
+
+    // Execute every stage once and return when all have finished. Without a pool
+    // stages run serially in insertion order.
+    void run(ThreadPool* pool);
+
+    size_t size() const { return m_stages.size(); }
+    const std::string& name(StageId id) const { return m_stages[id]->name; }
+    double start_ms(StageId id) const;    // relative to the start of the last run
+    double duration_ms(StageId id) const;
+    double total_ms() const { return static_cast<double>(m_total_ns) * 1e-6; }
+
+private:
+    struct Stage
+    {
+        std::string name;
+        const char* profile_name = nullptr; // interned name for PROFILE_ZONE
+        std::function<void()> fn;
+        Affinity affinity;
+        std::vector<StageId> dependents;
+        size_t dependency_count = 0;
+        std::atomic<size_t> remaining{0};
+        std::atomic<bool> ready{false};
+        bool started = false; // caller stages only
+        int64_t start_ns = 0, end_ns = 0;
+    };
+
+    static void run_stage_task(void* ctx, size_t id, size_t);
+    void execute(StageId id);
+    void schedule(StageId id);
+
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    ThreadPool* m_pool = nullptr;       // pool of the current run
+    ThreadPool::TaskGroup m_group;
+    std::atomic<size_t> m_done{0};
+    int64_t m_run_start_ns = 0;
+    int64_t m_total_ns = 0;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing thread pool for data-parallel frame work. Every worker owns a
+// bounded task queue: it pops its own work LIFO and steals FIFO from the others
+// when empty. Idle workers spin briefly, so the next job in the same frame is
+// picked up without a wake-up, and then park on a condition variable so an idle
+// pool costs no CPU between frames. Threads that submit work help run tasks
+// while they wait. Tasks are plain function pointer + context records, so
+// submitting never allocates.
+class ThreadPool
+{
+public:
+    using TaskFn = void (*)(void* ctx, size_t begin, size_t end);
+
+    // Completion counter for individually submitted tasks.
+    struct TaskGroup
+    {
+        std::atomic<size_t> pending{0};
+    };
+
+    // threads is the total parallelism including the calling thread (0 = one per
+    // hardware thread). ThreadPool(1) starts no workers and runs everything inline.
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t thread_count() const { return m_workers.size() + 1; }
+
+    // Call fn(begin, end) over [0, count) in chunks of at most `grain` items and
+    // return once every chunk has run. fn may be called concurrently and must not throw.
+    template <typename F>
+    void parallel_for(size_t count, size_t grain, F&& fn)
+    {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (m_workers.empty() || count <= grain) { fn(size_t{0}, count); return; }
+
+        using Fn = std::remove_reference_t<F>;
+        run(&invoke<Fn>, const_cast<void*>(static_cast<const void*>(&fn)), count, grain);
+    }
+
+    // Queue fn(ctx, begin, end) as one task counted by group. Runs inline when the
+    // pool has no workers or the target queue is full.
+    void submit(TaskGroup& group, TaskFn fn, void* ctx, size_t begin = 0, size_t end = 0);
+
+    // Run one queued task on the calling thread if there is one. Returns false if idle.
+    bool help();
+
+    // Help run tasks until every task submitted to group has finished.
+    void wait(TaskGroup& group);
+
+private:
+    struct Task
+    {
+        TaskFn fn = nullptr;
+        void* ctx = nullptr;
+        size_t begin = 0, end = 0;
+        std::atomic<size_t>* pending = nullptr;
+    };
+
+    // Bounded ring of tasks guarded by a short mutex. Owner pops from the back,
+    // thieves take from the front.
+    struct alignas(64) WorkQueue
+    {
+        static constexpr size_t kCapacity = 1024;
+
+        std::mutex mutex;
+        std::unique_ptr<Task[]> ring{ new Task[kCapacity] };
+        size_t head = 0, tail = 0; // tail - head tasks in flight
+
+        bool push(const Task& task);
+        bool pop_back(Task& task);
+        bool steal(Task& task);
+    };
+
+    template <typename Fn>
+    static void invoke(void* ctx, size_t begin, size_t end) { (*static_cast<Fn*>(ctx))(begin, end); }
+
+    void run(TaskFn fn, void* ctx, size_t count, size_t grain);
+    bool try_take(size_t self, Task& task);
+    void execute(const Task& task);
+    void wake_workers();
+    void worker_main(size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues; // one per worker
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_queued{0};                  // tasks sitting in queues
+    std::atomic<size_t> m_parked{0};
+    std::atomic<size_t> m_next_queue{0};              // round-robin for external submitters
+    std::atomic<bool> m_stop{false};
+    std::mutex m_park_mutex;
+    std::condition_variable m_park_cv;
+};
+
+#endif
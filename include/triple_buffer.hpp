@@ -0,0 +1,45 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer. The writer fills
+// write_buffer() and publish()es it; the reader always gets the most recent
+// complete buffer from read() without blocking the writer or seeing a partial
+// write. The three buffers rotate through a single atomic "middle" index whose
+// high bit marks unread data, so buffer memory is reused rather than reallocated.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Writer side
+    T& write_buffer() { return m_buffers[m_back]; }
+    void publish()
+    {
+        const uint8_t prev = m_middle.exchange(static_cast<uint8_t>(m_back | kDirty), std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+    }
+
+    // Reader side. The returned buffer stays valid until the next read().
+    const T& read()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & kDirty)
+        {
+            const uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = prev & kIndexMask;
+        }
+        return m_buffers[m_front];
+    }
+
+private:
+    static constexpr uint8_t kDirty = 0x80;
+    static constexpr uint8_t kIndexMask = 0x03;
+
+    T m_buffers[3];
+    uint8_t m_back = 0;                 // writer-owned
+    uint8_t m_front = 1;                // reader-owned
+    std::atomic<uint8_t> m_middle{ 2 }; // shared hand-off slot
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "compaction.hpp"
+#include <algorithm>
+#include <utility>
+
+void CompactionBuffers::reserve(size_t capacity)
+{
+    keep.reserve(capacity);
+    offsets.reserve(compaction_chunks(capacity) + 1);
+}
+
+void begin_compaction(CompactionBuffers& buf, size_t n)
+{
+    buf.keep.resize(n);
+    buf.offsets.assign(compaction_chunks(n) + 1, 0);
+}
+
+void expire_chunk(ParticleStore& store, CompactionBuffers& buf, size_t chunk, float dt)
+{
+    const size_t begin = chunk * kCompactionChunk;
+    const size_t end = std::min(begin + kCompactionChunk, store.size());
+    float* age = store.age.data();
+    const float* lifetime = store.lifetime.data();
+    uint8_t* keep = buf.keep.data();
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        float a = age[i] + dt;
+        age[i] = a;
+        keep[i] = !(lifetime[i] > 0.0f && a >= lifetime[i]);
+    }
+}
+
+void count_survivors(CompactionBuffers& buf, size_t chunk)
+{
+    const size_t begin = chunk * kCompactionChunk;
+    const size_t end = std::min(begin + kCompactionChunk, buf.keep.size());
+    const uint8_t* keep = buf.keep.data();
+
+    size_t survivors = 0;
+    for (size_t i = begin; i < end; ++i) survivors += keep[i];
+    buf.offsets[chunk] = survivors;
+}
+
+size_t scan_survivors(CompactionBuffers& buf, ParticleStore& scratch)
+{
+    // Exclusive scan; the trailing entry ends up holding the total
+    size_t running = 0;
+    for (size_t& offset : buf.offsets)
+    {
+        size_t count = offset;
+        offset = running;
+        running += count;
+    }
+
+    const size_t survivors = buf.offsets.back();
+    if (survivors != buf.keep.size()) scratch.resize(survivors);
+    return survivors;
+}
+
+void scatter_chunk(ParticleStore& store, const CompactionBuffers& buf, ParticleStore& scratch, size_t chunk)
+{
+    const size_t begin = chunk * kCompactionChunk;
+    const size_t end = std::min(begin + kCompactionChunk, store.size());
+    const size_t out = buf.offsets[chunk];
+    const uint8_t* keep = buf.keep.data();
+
+    store.for_each_column(scratch, [&](auto& src, auto& dst)
+    {
+        size_t o = out;
+        for (size_t i = begin; i < end; ++i)
+            if (keep[i]) dst[o++] = src[i];
+    });
+}
+
+void finish_compaction(ParticleStore& store, ParticleStore& scratch)
+{
+    // Swapping exchanges buffers, so both stores keep their reserved capacity
+    store.for_each_column(scratch, [](auto& a, auto& b) { a.swap(b); });
+}
+
+size_t compact(ParticleStore& store, CompactionBuffers& buf, ParticleStore& scratch)
+{
+    const size_t n = store.size();
+    const size_t chunks = compaction_chunks(n);
+    for (size_t c = 0; c < chunks; ++c) count_survivors(buf, c);
+
+    const size_t survivors = scan_survivors(buf, scratch);
+    if (survivors == n) return 0;
+
+    for (size_t c = 0; c < chunks; ++c) scatter_chunk(store, buf, scratch, c);
+    finish_compaction(store, scratch);
+    return n - survivors;
+}
+
+size_t expire(ParticleStore& store, CompactionBuffers& buf, ParticleStore& scratch, float dt)
+{
+    const size_t n = store.size();
+    begin_compaction(buf, n);
+    for (size_t c = 0; c < compaction_chunks(n); ++c) expire_chunk(store, buf, c, dt);
+    return compact(store, buf, scratch);
+}
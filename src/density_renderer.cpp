@@ -0,0 +1,172 @@
+#include "density_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr size_t kRowsPerTask = 16;
+
+    // Perceptually ordered dark-to-bright ramp (approximates "inferno")
+    struct ColorStop { float t; float r, g, b; };
+    constexpr ColorStop kStops[] = {
+        { 0.00f, 0.00f, 0.00f, 0.02f },
+        { 0.25f, 0.26f, 0.04f, 0.41f },
+        { 0.50f, 0.73f, 0.21f, 0.33f },
+        { 0.75f, 0.98f, 0.55f, 0.04f },
+        { 1.00f, 0.99f, 1.00f, 0.64f },
+    };
+
+    uint32_t pack(float r, float g, float b)
+    {
+        auto to8 = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return 0xFF000000u | (to8(r) << 16) | (to8(g) << 8) | to8(b);
+    }
+
+    template <typename F>
+    void for_range(ThreadPool* pool, size_t count, size_t grain, F&& f)
+    {
+        if (pool) pool->parallel_for(count, grain, f);
+        else f(size_t{0}, count);
+    }
+}
+
+DensityRenderer::DensityRenderer(ThreadPool* thread_pool)
+    : m_thread_pool(thread_pool), m_slices(std::min(thread_pool ? thread_pool->thread_count() : size_t{1}, kMaxSlices))
+{
+    for (int i = 0; i < 256; ++i)
+    {
+        const float t = static_cast<float>(i) / 255.0f;
+        size_t s = 1;
+        while (s + 1 < std::size(kStops) && kStops[s].t < t) ++s;
+        const ColorStop& a = kStops[s - 1];
+        const ColorStop& b = kStops[s];
+        const float f = (t - a.t) / (b.t - a.t);
+        m_colormap[i] = pack(a.r + (b.r - a.r) * f, a.g + (b.g - a.g) * f, a.b + (b.b - a.b) * f);
+    }
+}
+
+DensityRenderer::~DensityRenderer()
+{
+    release();
+}
+
+void DensityRenderer::release()
+{
+    if (m_texture) SDL_DestroyTexture(m_texture);
+    m_texture = nullptr;
+    m_texture_renderer = nullptr;
+}
+
+bool DensityRenderer::parse_weight(const std::string& name, Weight& weight)
+{
+    if (name == "count") { weight = Weight::Count; return true; }
+    if (name == "speed") { weight = Weight::Speed; return true; }
+    return false;
+}
+
+const char* DensityRenderer::weight_name(Weight weight)
+{
+    return weight == Weight::Speed ? "speed" : "count";
+}
+
+void DensityRenderer::resize(int width, int height)
+{
+    if (width == m_width && height == m_height) return;
+    m_width = width;
+    m_height = height;
+    const size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    m_grids.assign(m_slices * pixels, 0.0f);
+    m_used = 0;
+    m_pixels.assign(pixels, 0xFF000000u);
+    m_row_peaks.assign(static_cast<size_t>(height), 0.0f);
+}
+
+void DensityRenderer::begin(const ViewParams& view)
+{
+    m_view = view;
+    resize(std::max(static_cast<int>(view.width), 1), std::max(static_cast<int>(view.height), 1));
+
+    // Only the grids the last frame wrote are dirty
+    const size_t dirty = m_used * static_cast<size_t>(m_width) * static_cast<size_t>(m_height);
+    for_range(m_thread_pool, dirty, size_t{1} << 16, [this](size_t begin, size_t end)
+    {
+        std::fill(m_grids.begin() + static_cast<std::ptrdiff_t>(begin), m_grids.begin() + static_cast<std::ptrdiff_t>(end), 0.0f);
+    });
+    m_used = 0;
+}
+
+void DensityRenderer::accumulate(const ParticleStore& store)
+{
+    const size_t n = store.size();
+    if (n == 0) return;
+
+    const SimpleCamera& cam = m_view.camera;
+    const float half_w = m_view.width * 0.5f;
+    const float half_h = m_view.height * 0.5f;
+    const size_t pixels = static_cast<size_t>(m_width) * static_cast<size_t>(m_height);
+    const Weight weight = m_weight;
+
+    // Slice s of the particles goes into private grid s; small stores use fewer grids
+    const size_t slices = std::clamp(n / kSliceParticles, size_t{1}, m_slices);
+    m_used = std::max(m_used, slices);
+    for_range(m_thread_pool, slices, 1, [&](size_t first, size_t last)
+    {
+        for (size_t s = first; s < last; ++s)
+        {
+            float* grid = m_grids.data() + s * pixels;
+            const size_t end = n * (s + 1) / slices;
+            for (size_t i = n * s / slices; i < end; ++i)
+            {
+                const float sx = (m_view.lerp(store.prev_x[i], store.x[i]) - cam.x) * cam.scale + half_w;
+                const float sy = (m_view.lerp(store.prev_y[i], store.y[i]) - cam.y) * cam.scale + half_h;
+                if (!(sx >= 0.0f && sy >= 0.0f && sx < static_cast<float>(m_width) && sy < static_cast<float>(m_height))) continue;
+                const size_t p = static_cast<size_t>(sy) * static_cast<size_t>(m_width) + static_cast<size_t>(sx);
+                grid[p] += weight == Weight::Speed ? std::sqrt(store.vx[i] * store.vx[i] + store.vy[i] * store.vy[i]) : 1.0f;
+            }
+        }
+    });
+}
+
+void DensityRenderer::draw(SDL_Renderer* renderer)
+{
+    const size_t w = static_cast<size_t>(m_width);
+    const size_t pixels = w * static_cast<size_t>(m_height);
+
+    // Fold the written private grids into grid 0 and track each row's peak
+    for_range(m_thread_pool, static_cast<size_t>(m_height), kRowsPerTask, [&](size_t first, size_t last)
+    {
+        for (size_t y = first; y < last; ++y)
+        {
+            float* row = m_grids.data() + y * w;
+            for (size_t s = 1; s < m_used; ++s)
+            {
+                const float* other = m_grids.data() + s * pixels + y * w;
+                for (size_t x = 0; x < w; ++x) row[x] += other[x];
+            }
+            m_row_peaks[y] = *std::max_element(row, row + w);
+        }
+    });
+    m_peak = *std::max_element(m_row_peaks.begin(), m_row_peaks.end());
+
+    // Log tone map through the colormap
+    const float scale = m_peak > 0.0f ? 255.0f / std::log1p(m_peak) : 0.0f;
+    for_range(m_thread_pool, static_cast<size_t>(m_height), kRowsPerTask, [&](size_t first, size_t last)
+    {
+        for (size_t i = first * w; i < last * w; ++i)
+            m_pixels[i] = m_colormap[std::min(static_cast<int>(std::log1p(m_grids[i]) * scale), 255)];
+    });
+
+    if (!m_texture || renderer != m_texture_renderer || m_width != m_texture_width || m_height != m_texture_height)
+    {
+        if (m_texture) SDL_DestroyTexture(m_texture);
+        m_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STREAMING, m_width, m_height);
+        if (!m_texture) { SDL_Log("Density renderer: texture creation failed: %s", SDL_GetError()); return; }
+        SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_NONE);
+        SDL_SetTextureScaleMode(m_texture, SDL_SCALEMODE_NEAREST);
+        m_texture_renderer = renderer;
+        m_texture_width = m_width;
+        m_texture_height = m_height;
+    }
+    SDL_UpdateTexture(m_texture, nullptr, m_pixels.data(), m_width * static_cast<int>(sizeof(uint32_t)));
+    SDL_RenderTexture(renderer, m_texture, nullptr, nullptr);
+}
@@ -0,0 +1,127 @@
+#include "frame_pacer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace
+{
+    constexpr uint64_t kInitialSlackNs = 200000; // 0.2 ms, refined by measurement
+    constexpr uint64_t kMinSlackNs = 20000;
+    constexpr uint64_t kMaxSlackNs = 4000000;
+    constexpr uint64_t kSlackDecay = 64;         // slack relaxes by 1/64 of the gap per sleep
+}
+
+FramePacer::FramePacer(double target_fps, size_t history)
+    : m_slack_ns(kInitialSlackNs), m_history(std::max<size_t>(history, 1))
+{
+    set_target_fps(target_fps);
+    m_last_ns = now_ns();
+}
+
+uint64_t FramePacer::now_ns()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void FramePacer::set_target_fps(double fps)
+{
+    m_period_ns = fps > 0.0 ? static_cast<uint64_t>(1e9 / fps) : 0;
+    m_deadline_ns = now_ns() + m_period_ns;
+}
+
+void FramePacer::sleep_until(uint64_t deadline_ns)
+{
+    // Coarse OS sleep up to one slack estimate before the deadline
+    const uint64_t wake_ns = deadline_ns - std::min(m_slack_ns, deadline_ns);
+    uint64_t now = now_ns();
+    if (now < wake_ns)
+    {
+#if defined(__linux__)
+        // libstdc++/libc++ steady_clock is CLOCK_MONOTONIC, so the deadline can be used directly
+        timespec ts{ static_cast<time_t>(wake_ns / 1000000000ULL), static_cast<long>(wake_ns % 1000000000ULL) };
+        int rc;
+        // Resume after signals; any other error (returned, not in errno) leaves the
+        // rest of the wait to the spin below
+        while ((rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)) == EINTR) {}
+        const bool slept = rc == 0;
+#else
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wake_ns - now));
+        const bool slept = true;
+#endif
+        now = now_ns();
+
+        // Late wake: raise the estimate at once. Early/on time: let it decay toward what was seen
+        if (slept)
+        {
+            const uint64_t late = now > wake_ns ? now - wake_ns : 0;
+            if (late > m_slack_ns) m_slack_ns = late;
+            else m_slack_ns -= (m_slack_ns - late) / kSlackDecay;
+            m_slack_ns = std::clamp(m_slack_ns, kMinSlackNs, kMaxSlackNs);
+        }
+    }
+
+    // Short spin for the remainder
+    const uint64_t spin_start = now;
+    while (now < deadline_ns)
+    {
+        std::this_thread::yield();
+        now = now_ns();
+    }
+    m_spin_ns += now - spin_start;
+}
+
+double FramePacer::wait()
+{
+    if (m_period_ns)
+    {
+        const uint64_t now = now_ns();
+        if (now > m_deadline_ns + m_period_ns) m_deadline_ns = now; // overran: restart the schedule
+        else sleep_until(m_deadline_ns);
+        m_deadline_ns += m_period_ns;
+    }
+
+    const uint64_t now = now_ns();
+    const uint64_t frame_ns = now - m_last_ns;
+    m_last_ns = now;
+    m_wall_ns += frame_ns;
+
+    m_history[m_history_next] = static_cast<float>(static_cast<double>(frame_ns) * 1e-6);
+    m_history_next = (m_history_next + 1) % m_history.size();
+    m_history_count = std::min(m_history_count + 1, m_history.size());
+    return static_cast<double>(frame_ns) * 1e-9;
+}
+
+FrameTimeStats FramePacer::stats() const
+{
+    FrameTimeStats s;
+    s.frames = m_history_count;
+    if (m_history_count == 0) return s;
+
+    std::vector<float> sorted(m_history.begin(), m_history.begin() + m_history_count);
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return static_cast<double>(sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5)]); };
+
+    double sum = 0.0;
+    for (float v : sorted) sum += v;
+    s.mean_ms = sum / static_cast<double>(sorted.size());
+    s.p50_ms = pct(0.50);
+    s.p90_ms = pct(0.90);
+    s.p99_ms = pct(0.99);
+    s.max_ms = sorted.back();
+    s.spin_fraction = m_wall_ns ? static_cast<double>(m_spin_ns) / static_cast<double>(m_wall_ns) : 0.0;
+    return s;
+}
+
+void FramePacer::reset_stats()
+{
+    m_history_next = 0;
+    m_history_count = 0;
+    m_spin_ns = 0;
+    m_wall_ns = 0;
+}
@@ -0,0 +1,31 @@
+#include "geometry_batch.hpp"
+#include <algorithm>
+
+Vertex* GeometryBatch::append(size_t quads)
+{
+    const size_t needed = (m_quads + quads) * 4;
+    if (m_vertices.size() < needed)
+    {
+        m_vertices.resize(std::max(needed, m_vertices.size() * 2));
+        m_shapes.resize(m_vertices.size() / 4);
+    }
+    return m_vertices.data() + m_quads * 4;
+}
+
+void GeometryBatch::commit(size_t quads, QuadShape shape)
+{
+    std::fill_n(m_shapes.data() + m_quads, quads, shape);
+    m_quads += quads;
+}
+
+void GeometryBatch::flush(RenderBackend& backend, TextureId texture)
+{
+    m_draw_calls = 0;
+    for (size_t first = 0; first < m_quads; first += kQuadsPerDraw)
+    {
+        const size_t n = std::min(kQuadsPerDraw, m_quads - first);
+        backend.draw_quads(m_vertices.data() + first * 4, n, texture);
+        ++m_draw_calls;
+    }
+    m_quads = 0;
+}
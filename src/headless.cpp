@@ -0,0 +1,87 @@
+#include "headless.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "frame_pacer.hpp"
+#include "profiler.hpp"
+#include "simd_kernels.hpp"
+#include "simple_particle.hpp"
+
+HeadlessRunner::HeadlessRunner(const Config& config)
+    : m_config(config),
+      m_thread_pool(static_cast<size_t>(std::max(config.get_worker_threads(), 0))),
+      m_particle_system(&m_thread_pool)
+{
+    PROFILE_THREAD("main");
+    if (config.is_profiler()) Profiler::get_instance().set_enabled(true);
+    std::string simd_warning;
+    const SimdLevel simd = configure_simd_kernels(config.get_simd_kernel(), simd_warning);
+    if (!simd_warning.empty()) std::fprintf(stderr, "%s\n", simd_warning.c_str());
+    const size_t requested = config.get_headless_particles() > 0 ? static_cast<size_t>(config.get_headless_particles())
+                                                                  : m_particle_system.capacity();
+    const size_t spawned = spawn_scene(m_particle_system, config, requested);
+    std::printf("Headless: %zu particles (requested %zu), %zu threads, %s kernels\n", spawned, requested,
+                m_thread_pool.thread_count(), simd_level_name(simd));
+}
+
+size_t HeadlessRunner::spawn_scene(ParticleSystem& ps, const Config& config, size_t count, uint32_t seed)
+{
+    // Spread over the window at the default camera scale so the same scene is
+    // meaningful when rendered; lifetime 0 keeps the count steady across a run
+    const SimpleCamera camera;
+    const float half_w = static_cast<float>(config.get_window_width()) * 0.5f / camera.scale;
+    const float half_h = static_cast<float>(config.get_window_height()) * 0.5f / camera.scale;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> px(-half_w, half_w), py(-half_h, half_h), v(-2.0f, 2.0f);
+    std::uniform_int_distribution<int> channel(64, 255);
+
+    size_t added = 0;
+    for (; added < count; ++added)
+    {
+        const Color color{ static_cast<uint8_t>(channel(rng)), static_cast<uint8_t>(channel(rng)), static_cast<uint8_t>(channel(rng)), 255 };
+        if (!ps.addParticle(SimpleParticle(px(rng), py(rng), v(rng), v(rng), config.get_default_particle_radius(), color))) break;
+    }
+    return added;
+}
+
+HeadlessStats HeadlessRunner::run(uint64_t steps)
+{
+    if (steps == 0) steps = static_cast<uint64_t>(std::max(m_config.get_headless_steps(), 1));
+    const SimParams params = SimParams::from_config(m_config, m_config.get_sim_step());
+
+    HeadlessStats stats;
+    uint64_t elapsed = 0; // in update() only, not the progress output
+    uint64_t next_report = FramePacer::now_ns() + 1'000'000'000ull;
+    for (; stats.steps < steps; ++stats.steps)
+    {
+        stats.particle_updates += m_particle_system.count();
+        const uint64_t start = FramePacer::now_ns();
+        m_particle_system.update(params);
+        const uint64_t now = FramePacer::now_ns();
+        elapsed += now - start;
+
+        if (now >= next_report)
+        {
+            stats.seconds = static_cast<double>(elapsed) * 1e-9;
+            std::printf("  step %llu/%llu  %.1f steps/s\n", static_cast<unsigned long long>(stats.steps + 1),
+                        static_cast<unsigned long long>(steps), static_cast<double>(stats.steps + 1) / stats.seconds);
+            std::fflush(stdout);
+            next_report = now + 1'000'000'000ull;
+        }
+    }
+    stats.seconds = static_cast<double>(elapsed) * 1e-9;
+    stats.particles = m_particle_system.count();
+
+    std::printf("Headless: %llu steps in %.3f s: %.1f steps/s, %.4g particle-updates/s (%.2f ns/particle)\n",
+                static_cast<unsigned long long>(stats.steps), stats.seconds, stats.steps_per_second(), stats.updates_per_second(),
+                stats.particle_updates ? stats.seconds * 1e9 / static_cast<double>(stats.particle_updates) : 0.0);
+
+    if (Profiler::enabled())
+    {
+        const Profiler& profiler = Profiler::get_instance();
+        if (profiler.write_chrome_trace(m_config.get_profiler_output()))
+            std::printf("Profiler: wrote %zu zones to %s\n", profiler.zone_count(), m_config.get_profiler_output().c_str());
+        else std::printf("Profiler: cannot write %s\n", m_config.get_profiler_output().c_str());
+    }
+    return stats;
+}
@@ -0,0 +1,148 @@
+#include "lod_aggregator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr size_t kRowsPerTask = 8;
+
+    template <typename F>
+    void for_range(ThreadPool* pool, size_t count, size_t grain, F&& f)
+    {
+        if (pool) pool->parallel_for(count, grain, f);
+        else f(size_t{0}, count);
+    }
+}
+
+LodAggregator::LodAggregator(ThreadPool* thread_pool)
+    : m_thread_pool(thread_pool),
+      m_slices(std::min(thread_pool ? thread_pool->thread_count() : size_t{1}, kMaxSlices)),
+      m_merged(m_slices, 0)
+{}
+
+void LodAggregator::begin(const ViewParams& view)
+{
+    m_view = view;
+    m_active = view.lod_threshold_px > 0.0f && view.width >= 1.0f && view.height >= 1.0f;
+    std::fill(m_merged.begin(), m_merged.end(), 0);
+    if (!m_active) return;
+
+    m_cell_px = std::max(view.lod_cell_px, 1.0f);
+    const int cols = static_cast<int>(std::ceil(view.width / m_cell_px));
+    const int rows = static_cast<int>(std::ceil(view.height / m_cell_px));
+    if (cols != m_cols || rows != m_rows)
+    {
+        m_cols = cols;
+        m_rows = rows;
+        m_grids.assign(m_slices * static_cast<size_t>(cols) * static_cast<size_t>(rows), Cell{});
+        m_row_offsets.resize(static_cast<size_t>(rows) + 1);
+    }
+}
+
+size_t LodAggregator::filter(ConstParticleSpan span, uint32_t* visible, size_t count, size_t slice)
+{
+    const SimpleCamera& cam = m_view.camera;
+    const float half_w = m_view.width * 0.5f;
+    const float half_h = m_view.height * 0.5f;
+    const float threshold = m_view.lod_threshold_px;
+    const float inv_cell = 1.0f / m_cell_px;
+    const float max_col = static_cast<float>(m_cols - 1);
+    const float max_row = static_cast<float>(m_rows - 1);
+    Cell* grid = m_grids.data() + slice * static_cast<size_t>(m_cols) * static_cast<size_t>(m_rows);
+    constexpr float kInv255 = 1.0f / 255.0f;
+
+    size_t kept = 0;
+    for (size_t k = 0; k < count; ++k)
+    {
+        const uint32_t i = visible[k];
+        const float rpx = span.radius[i] * cam.scale;
+        if (rpx >= threshold)
+        {
+            visible[kept++] = i;
+            continue;
+        }
+
+        // Culled particles may straddle the border; clamp them into edge cells
+        const float sx = (m_view.lerp(span.prev_x[i], span.x[i]) - cam.x) * cam.scale + half_w;
+        const float sy = (m_view.lerp(span.prev_y[i], span.y[i]) - cam.y) * cam.scale + half_h;
+        const size_t col = static_cast<size_t>(std::clamp(sx * inv_cell, 0.0f, max_col));
+        const size_t row = static_cast<size_t>(std::clamp(sy * inv_cell, 0.0f, max_row));
+
+        const Color& c = span.color[i];
+        const float w = 4.0f * rpx * rpx * (c.a * kInv255); // drawn square area * alpha
+        Cell& cell = grid[row * static_cast<size_t>(m_cols) + col];
+        cell.r += c.r * kInv255 * w;
+        cell.g += c.g * kInv255 * w;
+        cell.b += c.b * kInv255 * w;
+        cell.weight += w;
+    }
+    m_merged[slice] += count - kept;
+    return kept;
+}
+
+size_t LodAggregator::merged() const
+{
+    size_t n = 0;
+    for (size_t m : m_merged) n += m;
+    return n;
+}
+
+size_t LodAggregator::emit(GeometryBatch& out)
+{
+    if (!m_active || merged() == 0) return 0;
+
+    const size_t cols = static_cast<size_t>(m_cols);
+    const size_t cells = cols * static_cast<size_t>(m_rows);
+
+    // Fold slices into slice 0 (zeroing the others) and count occupied cells per row
+    for_range(m_thread_pool, static_cast<size_t>(m_rows), kRowsPerTask, [&](size_t first, size_t last)
+    {
+        for (size_t row = first; row < last; ++row)
+        {
+            Cell* dst = m_grids.data() + row * cols;
+            for (size_t s = 1; s < m_slices; ++s)
+            {
+                Cell* src = m_grids.data() + s * cells + row * cols;
+                for (size_t c = 0; c < cols; ++c)
+                {
+                    dst[c].r += src[c].r; dst[c].g += src[c].g; dst[c].b += src[c].b; dst[c].weight += src[c].weight;
+                    src[c] = Cell{};
+                }
+            }
+            uint32_t occupied = 0;
+            for (size_t c = 0; c < cols; ++c) occupied += dst[c].weight > 0.0f;
+            m_row_offsets[row] = occupied;
+        }
+    });
+
+    uint32_t total = 0;
+    for (size_t row = 0; row < static_cast<size_t>(m_rows); ++row) { const uint32_t n = m_row_offsets[row]; m_row_offsets[row] = total; total += n; }
+    m_row_offsets[static_cast<size_t>(m_rows)] = total;
+    if (total == 0) return 0;
+
+    // One quad per occupied cell, rows in parallel at their offsets; zero slice 0 as we go
+    Vertex* quads = out.append(total);
+    const float cell_area = m_cell_px * m_cell_px;
+    const float half = m_cell_px * 0.5f;
+    for_range(m_thread_pool, static_cast<size_t>(m_rows), kRowsPerTask, [&](size_t first, size_t last)
+    {
+        for (size_t row = first; row < last; ++row)
+        {
+            Vertex* v = quads + static_cast<size_t>(m_row_offsets[row]) * 4;
+            Cell* src = m_grids.data() + row * cols;
+            const float cy = (static_cast<float>(row) + 0.5f) * m_cell_px;
+            for (size_t c = 0; c < cols; ++c)
+            {
+                const Cell cell = src[c];
+                if (cell.weight <= 0.0f) continue;
+                src[c] = Cell{};
+                const float inv = 1.0f / cell.weight;
+                const FColor color{ cell.r * inv, cell.g * inv, cell.b * inv, std::min(cell.weight / cell_area, 1.0f) };
+                GeometryBatch::write_quad(v, (static_cast<float>(c) + 0.5f) * m_cell_px, cy, half, color);
+                v += 4;
+            }
+        }
+    });
+    out.commit(total, QuadShape::Rect);
+    return total;
+}
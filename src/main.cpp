@@ -1,16 +1,31 @@
 #include <state.hpp>
+#include <headless.hpp>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char* argv[])
 {
     try
     {
+        Config& config = Config::get_instance();
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--headless") == 0) config.set_headless(true);
+            if (std::strcmp(argv[i], "--profile") == 0) config.set_profiler(true);
+        }
+
+        // Headless runs never touch State, so SDL video is not initialized
+        if (config.is_headless())
+        {
+            HeadlessRunner runner(config);
+            runner.run();
+            return EXIT_SUCCESS;
+        }
+
         State& state = State::get_instance();
         while (!state.should_quit())
         {
-            state.render();
-            state.process_input();
-            state.update();
+            state.run_frame();
         }
         return EXIT_SUCCESS;
 
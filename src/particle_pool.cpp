@@ -0,0 +1,68 @@
+#include "particle_pool.hpp"
+#include <algorithm>
+#include <new>
+
+ParticlePool::ParticlePool(size_t max_blocks)
+    : m_slab_blocks(std::clamp<size_t>(max_blocks, 1, 4096))
+{}
+
+size_t ParticlePool::class_of(size_t size)
+{
+    size_t cls = 0;
+    while (class_size(cls) < size) ++cls;
+    return cls;
+}
+
+void ParticlePool::grow(size_t cls)
+{
+    const size_t block = class_size(cls);
+    // operator new[] for std::byte is aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__ (>= max_align_t)
+    auto slab = std::make_unique<std::byte[]>(block * m_slab_blocks);
+    std::byte* base = slab.get();
+    for (size_t i = m_slab_blocks; i-- > 0;)
+    {
+        auto* node = reinterpret_cast<FreeBlock*>(base + i * block);
+        node->next = m_free[cls];
+        m_free[cls] = node;
+    }
+    m_slabs.push_back(std::move(slab));
+}
+
+void* ParticlePool::allocate(size_t size, size_t align)
+{
+    if (size > kMaxBlockSize || align > kBlockAlign)
+    {
+        ++m_stats.misses;
+        return ::operator new(size, std::align_val_t(align));
+    }
+
+    const size_t cls = class_of(size);
+    if (!m_free[cls])
+    {
+        ++m_stats.misses;
+        grow(cls);
+    }
+    else
+    {
+        ++m_stats.hits;
+    }
+
+    FreeBlock* node = m_free[cls];
+    m_free[cls] = node->next;
+    return node;
+}
+
+void ParticlePool::deallocate(void* p, size_t size, size_t align)
+{
+    if (!p) return;
+    if (size > kMaxBlockSize || align > kBlockAlign)
+    {
+        ::operator delete(p, std::align_val_t(align));
+        return;
+    }
+
+    const size_t cls = class_of(size);
+    auto* node = static_cast<FreeBlock*>(p);
+    node->next = m_free[cls];
+    m_free[cls] = node;
+}
@@ -1,22 +1,396 @@
 #include "particle_system.hpp"
-#include <SDL3/SDL.h>
+#include <algorithm>
 
 #include "config.hpp"
+#include "profiler.hpp"
 
-void ParticleSystem::addParticle(std::unique_ptr<Particle> p)
+ParticleSystem::ParticleSystem(ThreadPool* thread_pool)
+    : m_thread_pool(thread_pool)
+    , m_capacity(static_cast<size_t>(std::max(Config::get_instance().get_max_particles(), 0)))
+    , m_pool(m_capacity)
+    , m_lod(thread_pool)
 {
-    const Config& cfg = Config::get_instance();
-    if (!p) return;
-    if (static_cast<int>(m_particles.size()) >= cfg.get_max_particles()) return; // respect max_particles
+    m_slots.reserve(m_capacity);
+    m_compaction_scratch.reserve(m_capacity);
+    registerType<SimpleParticle>();
+}
+
+size_t ParticleSystem::findBucket(std::type_index type) const
+{
+    for (size_t i = 0; i < m_buckets.size(); ++i)
+        if (m_buckets[i].type == type) return i;
+    return m_buckets.size();
+}
+
+void ParticleSystem::pushParticle(PooledParticle p)
+{
+    // The pointer table itself only grows until it reaches the peak live count
+    if (m_particles.size() == m_particles.capacity()) ++m_store_stats.misses;
     m_particles.push_back(std::move(p));
 }
 
-void ParticleSystem::update(float dt)
+bool ParticleSystem::addParticle(std::unique_ptr<Particle> p)
+{
+    if (!p) return false;
+    if (atCapacity()) return false; // respect max_particles
+    pushParticle(PooledParticle(p.release(), ParticleDeleter{}));
+    return true;
+}
+
+uint32_t ParticleSystem::acquireSlot(uint32_t bucket, uint32_t dense)
+{
+    uint32_t slot = m_free_slot;
+    if (slot != ParticleHandle::kInvalidIndex) m_free_slot = m_slots[slot].next_free;
+    else { slot = static_cast<uint32_t>(m_slots.size()); m_slots.emplace_back(); }
+
+    m_slots[slot].bucket = bucket;
+    m_slots[slot].dense = dense;
+    return slot;
+}
+
+void ParticleSystem::releaseSlot(uint32_t slot)
+{
+    Slot& s = m_slots[slot];
+    ++s.generation; // invalidates outstanding handles
+    s.next_free = m_free_slot;
+    m_free_slot = slot;
+}
+
+bool ParticleSystem::resolve(ParticleHandle handle, const Slot*& slot) const
+{
+    if (handle.index >= m_slots.size()) return false;
+    const Slot& s = m_slots[handle.index];
+    if (s.generation != handle.generation) return false;
+    slot = &s;
+    return true;
+}
+
+ParticleRef ParticleSystem::find(ParticleHandle handle)
+{
+    const Slot* slot = nullptr;
+    if (!resolve(handle, slot)) return {};
+    return { &m_buckets[slot->bucket].store, slot->bucket, slot->dense };
+}
+
+bool ParticleSystem::alive(ParticleHandle handle) const
+{
+    const Slot* slot = nullptr;
+    return resolve(handle, slot);
+}
+
+ParticleHandle ParticleSystem::handleAt(size_t bucket, size_t index) const
+{
+    const ParticleStore& store = m_buckets[bucket].store;
+    if (index >= store.size()) return {};
+    const uint32_t slot = store.slot[index];
+    return { slot, m_slots[slot].generation };
+}
+
+void ParticleSystem::killParticle(size_t bucket, size_t index)
+{
+    ParticleStore& store = m_buckets[bucket].store;
+    if (index >= store.size()) return;
+
+    releaseSlot(store.slot[index]);
+    store.swap_remove(index);
+    if (index < store.size()) m_slots[store.slot[index]].dense = static_cast<uint32_t>(index);
+    --m_batch_count;
+}
+
+bool ParticleSystem::killParticle(ParticleHandle handle)
+{
+    const Slot* slot = nullptr;
+    if (!resolve(handle, slot)) return false;
+    killParticle(slot->bucket, slot->dense);
+    return true;
+}
+
+size_t ParticleSystem::compactBucket(Bucket& bucket)
+{
+    ParticleStore& store = bucket.store;
+    CompactionBuffers& buf = bucket.compaction;
+    const size_t n = store.size();
+    const size_t survivors = scan_survivors(buf, m_compaction_scratch);
+    if (survivors == n) return 0;
+
+    // Free the slots of removed particles before their slot ids are dropped
+    const uint8_t* keep = buf.keep.data();
+    for (size_t i = 0; i < n; ++i) if (!keep[i]) releaseSlot(store.slot[i]);
+
+    forEachChunk(n, [&](size_t chunk) { scatter_chunk(store, buf, m_compaction_scratch, chunk); });
+    finish_compaction(store, m_compaction_scratch);
+
+    // Survivors moved down; repoint their slots (each slot is touched by one chunk)
+    const uint32_t* slots = store.slot.data();
+    Slot* table = m_slots.data();
+    forEachChunk(survivors, [&](size_t chunk)
+    {
+        const size_t begin = chunk * kCompactionChunk;
+        const size_t end = std::min(begin + kCompactionChunk, survivors);
+        for (size_t i = begin; i < end; ++i) table[slots[i]].dense = static_cast<uint32_t>(i);
+    });
+
+    const size_t removed = n - survivors;
+    m_batch_count -= removed;
+    return removed;
+}
+
+size_t ParticleSystem::memoryBytes() const
+{
+    size_t bytes = m_slots.capacity() * sizeof(Slot) + m_compaction_scratch.memory_bytes() + m_geometry.memory_bytes();
+    for (const auto& bucket : m_buckets)
+    {
+        const CompactionBuffers& c = bucket.compaction;
+        bytes += bucket.store.memory_bytes() + c.keep.capacity() + c.offsets.capacity() * sizeof(size_t);
+    }
+    for (const auto& batch : m_textured) bytes += batch.geometry.memory_bytes();
+    bytes += m_visible.capacity() * sizeof(uint32_t) + m_visible_counts.capacity() * sizeof(size_t);
+    return bytes;
+}
+
+AllocatorStats ParticleSystem::allocatorStats() const
+{
+    AllocatorStats stats = m_store_stats;
+    stats += m_pool.stats();
+    return stats;
+}
+
+void ParticleSystem::resetAllocatorStats()
+{
+    m_store_stats = {};
+    m_pool.reset_stats();
+}
+
+void ParticleSystem::buildUpdateGraph()
+{
+    m_update_graph.clear();
+
+    std::vector<TaskGraph::StageId> updates;
+    for (size_t b = 0; b < m_buckets.size(); ++b)
+        updates.push_back(m_update_graph.add("update:" + m_buckets[b].name, [this, b] { updateBucket(m_buckets[b]); }));
+    m_update_graph.add("plugins", [this] { updatePlugins(); });
+
+    // Compaction releases handle slots through the shared free list, so buckets compact one after another
+    m_update_graph.add("compact", [this]
+    {
+        for (auto& bucket : m_buckets)
+            if (!bucket.store.empty()) compactBucket(bucket);
+    }, updates);
+
+    m_graph_buckets = m_buckets.size();
+}
+
+void ParticleSystem::updateBucket(Bucket& bucket)
+{
+    const size_t n = bucket.store.size();
+    if (n == 0) return;
+
+    // Integrate, age and mark expired particles chunk by chunk
+    begin_compaction(bucket.compaction, n);
+    forEachChunk(n, [&](size_t chunk)
+    {
+        const size_t begin = chunk * kCompactionChunk;
+        const size_t end = std::min(begin + kCompactionChunk, n);
+        bucket.store.save_previous(begin, end);
+        bucket.kernels.update(bucket.store.span(begin, end), m_params);
+        expire_chunk(bucket.store, bucket.compaction, chunk, m_params.dt);
+        count_survivors(bucket.compaction, chunk);
+    });
+}
+
+void ParticleSystem::updatePlugins()
+{
+    std::lock_guard lock(m_plugin_mutex);
+    for (auto& p : m_particles) if (p) p->update(m_params.dt);
+
+    // Swap-and-pop dead polymorphic particles; their blocks go back to the pool
+    for (size_t i = 0; i < m_particles.size();)
+    {
+        if (m_particles[i]->alive()) { ++i; continue; }
+        std::swap(m_particles[i], m_particles.back());
+        m_particles.pop_back();
+    }
+}
+
+void ParticleSystem::update(const SimParams& params)
+{
+    PROFILE_ZONE("ParticleSystem::update");
+    m_params = params;
+    if (m_graph_buckets != m_buckets.size() || m_update_graph.size() == 0) buildUpdateGraph();
+    m_update_graph.run(m_thread_pool);
+    ++m_steps;
+    m_sim_time += params.dt;
+}
+
+void ParticleSystem::snapshot(ParticleSnapshot& out) const
+{
+    PROFILE_ZONE("ParticleSystem::snapshot");
+    out.batches.resize(m_buckets.size());
+    for (size_t b = 0; b < m_buckets.size(); ++b)
+    {
+        out.batches[b].kernels = m_buckets[b].kernels;
+        out.batches[b].atlas = m_buckets[b].atlas;
+        out.batches[b].store = m_buckets[b].store; // reuses the snapshot's capacity
+    }
+    out.update_stages.resize(m_update_graph.size());
+    for (size_t i = 0; i < m_update_graph.size(); ++i)
+    {
+        out.update_stages[i].name = m_update_graph.name(i);
+        out.update_stages[i].start_ms = m_update_graph.start_ms(i);
+        out.update_stages[i].duration_ms = m_update_graph.duration_ms(i);
+    }
+    out.step = m_steps;
+    out.sim_time = m_sim_time;
+}
+
+GeometryBatch& ParticleSystem::geometryFor(const SpriteAtlas* atlas, const ViewParams& view) const
+{
+    if (!atlas || !view.textured) return m_geometry;
+    for (auto& batch : m_textured)
+        if (batch.texture == atlas->texture()) return batch.geometry;
+    return m_textured.emplace_back(TexturedBatch{ atlas->texture(), {} }).geometry;
+}
+
+void ParticleSystem::flushGeometry(RenderBackend& backend) const
+{
+    PROFILE_ZONE("ParticleSystem::flushGeometry");
+    m_geometry.flush(backend);
+    for (auto& batch : m_textured) batch.geometry.flush(backend, batch.texture);
+}
+
+size_t ParticleSystem::lastDrawCalls() const
+{
+    size_t calls = m_geometry.last_draw_calls();
+    for (const auto& batch : m_textured) calls += batch.geometry.last_draw_calls();
+    return calls;
+}
+
+void ParticleSystem::emitGeometry(const ParticleKernels& kernels, const SpriteAtlas* atlas, const ParticleStore& store, const ViewParams& view) const
+{
+    const size_t n = store.size();
+    if (n == 0) return;
+
+    // Cull each chunk into its own slice of m_visible
+    const CullParams cull_params = view.cull_params();
+    const size_t chunks = compaction_chunks(n);
+    if (m_visible.size() < n) m_visible.resize(n);
+    m_visible_counts.resize(chunks);
+    {
+        PROFILE_ZONE("ParticleSystem::cull");
+        forEachChunk(n, [&](size_t chunk)
+        {
+            const size_t begin = chunk * kCompactionChunk;
+            const size_t end = std::min(begin + kCompactionChunk, n);
+            m_visible_counts[chunk] = cull(store.x.data() + begin, store.y.data() + begin, store.prev_x.data() + begin,
+                                           store.prev_y.data() + begin, store.radius.data() + begin, end - begin,
+                                           cull_params, static_cast<uint32_t>(begin), m_visible.data() + begin);
+        });
+    }
+
+    size_t visible = 0;
+    for (size_t c : m_visible_counts) visible += c;
+    m_cull_stats.visible += visible;
+    m_cull_stats.culled += n - visible;
+
+    // Divert sub-threshold particles to LOD cells, one grid slice per contiguous run of chunks
+    if (m_lod.active() && visible)
+    {
+        PROFILE_ZONE("ParticleSystem::lodFilter");
+        const ConstParticleSpan span = store.span();
+        const size_t slices = m_lod.slices();
+        auto filter = [&](size_t first, size_t last)
+        {
+            for (size_t s = first; s < last; ++s)
+                for (size_t chunk = chunks * s / slices; chunk < chunks * (s + 1) / slices; ++chunk)
+                    m_visible_counts[chunk] = m_lod.filter(span, m_visible.data() + chunk * kCompactionChunk, m_visible_counts[chunk], s);
+        };
+        if (m_thread_pool) m_thread_pool->parallel_for(slices, 1, filter);
+        else filter(0, slices);
+    }
+
+    visible = 0;
+    for (size_t& c : m_visible_counts) { const size_t count = c; c = visible; visible += count; }
+    if (visible == 0) return;
+
+    // Build vertices for the visible particles, each chunk at its offset in the batch
+    PROFILE_ZONE("ParticleSystem::emitVertices");
+    GeometryBatch& geometry = geometryFor(atlas, view);
+    const QuadShape shape = atlas ? QuadShape::Rect : QuadShape::Disc; // sprites stay square when drawn flat
+    if (&geometry == &m_geometry) atlas = nullptr;
+    Vertex* out = geometry.append(visible);
+    const ConstParticleSpan span = store.span();
+    forEachChunk(n, [&](size_t chunk)
+    {
+        const size_t first = m_visible_counts[chunk];
+        const size_t count = (chunk + 1 < chunks ? m_visible_counts[chunk + 1] : visible) - first;
+        if (count == 0) return;
+        const uint32_t* indices = m_visible.data() + chunk * kCompactionChunk;
+        Vertex* v = out + first * 4;
+        kernels.render(span, indices, count, v, view);
+
+        // Point each quad at its frame while the chunk's vertices are still in cache
+        if (atlas)
+        {
+            for (size_t k = 0; k < count; ++k, v += 4)
+            {
+                const SpriteUV& uv = atlas->uv(span.sprite[indices[k]]);
+                v[0].tex_coord = { uv.u0, uv.v0 }; v[1].tex_coord = { uv.u1, uv.v0 };
+                v[2].tex_coord = { uv.u1, uv.v1 }; v[3].tex_coord = { uv.u0, uv.v1 };
+            }
+        }
+    });
+    geometry.commit(visible, shape);
+}
+
+const GeometryBatch& ParticleSystem::buildGeometry(const ViewParams& view) const
+{
+    PROFILE_ZONE("ParticleSystem::buildGeometry");
+    m_geometry.clear();
+    for (auto& batch : m_textured) batch.geometry.clear();
+    m_cull_stats = {};
+    m_lod.begin(view);
+    for (const auto& bucket : m_buckets) emitGeometry(bucket.kernels, bucket.atlas, bucket.store, view);
+    finishGeometry();
+    return m_geometry;
+}
+
+const GeometryBatch& ParticleSystem::buildGeometry(const ParticleSnapshot& snapshot, const ViewParams& view) const
+{
+    PROFILE_ZONE("ParticleSystem::buildGeometry");
+    m_geometry.clear();
+    for (auto& batch : m_textured) batch.geometry.clear();
+    m_cull_stats = {};
+    m_lod.begin(view);
+    for (const auto& batch : snapshot.batches) emitGeometry(batch.kernels, batch.atlas, batch.store, view);
+    finishGeometry();
+    return m_geometry;
+}
+
+void ParticleSystem::finishGeometry() const
+{
+    if (!m_lod.active()) return;
+    PROFILE_ZONE("ParticleSystem::lodEmit");
+    m_cull_stats.merged = m_lod.merged();
+    m_cull_stats.lod_cells = m_lod.emit(m_geometry);
+}
+
+void ParticleSystem::renderPlugins(RenderBackend& backend, const ViewParams& view) const
+{
+    PROFILE_ZONE("ParticleSystem::renderPlugins");
+    std::lock_guard lock(m_plugin_mutex);
+    for (const auto& p : m_particles) if (p) p->render(backend, view.camera);
+}
+
+void ParticleSystem::render(const ParticleSnapshot& snapshot, RenderBackend& backend, const ViewParams& view) const
 {
-    for (auto& p : m_particles) if (p) p->update(dt);
+    buildGeometry(snapshot, view);
+    flushGeometry(backend);
+    renderPlugins(backend, view);
 }
 
-void ParticleSystem::render(SDL_Renderer* renderer, const SimpleCamera& cam) const
+void ParticleSystem::render(RenderBackend& backend, const ViewParams& view) const
 {
-    for (const auto& p : m_particles) if (p) p->render(renderer, cam);
+    buildGeometry(view);
+    flushGeometry(backend);
+    renderPlugins(backend, view);
 }
@@ -0,0 +1,147 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+Profiler& Profiler::get_instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+uint32_t Profiler::thread_id()
+{
+    thread_local uint32_t tid = s_next_tid.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+Profiler::ThreadRing& Profiler::ring()
+{
+    thread_local ThreadRing* t_ring = nullptr;
+    if (!t_ring)
+    {
+        auto ring = std::make_unique<ThreadRing>();
+        ring->tid = thread_id();
+        std::lock_guard lock(m_mutex);
+        t_ring = ring.get();
+        m_rings.push_back(std::move(ring));
+    }
+    return *t_ring;
+}
+
+void Profiler::record(const char* name, uint64_t start_ns, uint64_t end_ns)
+{
+    ThreadRing& r = ring();
+    // Claim before writing so a concurrent reader can tell the slot is being reused
+    const uint64_t index = r.claimed.load(std::memory_order_relaxed);
+    r.claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ThreadRing::Slot& slot = r.slots[index & (kRingCapacity - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(end_ns, std::memory_order_relaxed);
+    r.published.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::set_thread_name(const std::string& name)
+{
+    const uint32_t tid = thread_id();
+    std::lock_guard lock(m_mutex);
+    m_thread_names[tid] = name;
+}
+
+const char* Profiler::intern(const std::string& name)
+{
+    std::lock_guard lock(m_mutex);
+    return m_interned.insert(name).first->c_str();
+}
+
+std::vector<Profiler::Zone> Profiler::snapshot(const ThreadRing& r) const
+{
+    const uint64_t end = r.published.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(end > kRingCapacity ? end - kRingCapacity : 0, r.cleared.load(std::memory_order_relaxed));
+    std::vector<Zone> zones;
+    zones.reserve(end > begin ? end - begin : 0);
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        const ThreadRing::Slot& slot = r.slots[i & (kRingCapacity - 1)];
+        zones.push_back({ slot.name.load(std::memory_order_relaxed), slot.start_ns.load(std::memory_order_relaxed),
+                          slot.end_ns.load(std::memory_order_relaxed) });
+    }
+
+    // Slots claimed again while we copied may hold a mix of old and new zones
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = r.claimed.load(std::memory_order_relaxed);
+    const uint64_t valid = claimed > kRingCapacity ? claimed - kRingCapacity : 0;
+    if (valid > begin) zones.erase(zones.begin(), zones.begin() + static_cast<std::ptrdiff_t>(std::min<uint64_t>(valid - begin, zones.size())));
+    return zones;
+}
+
+size_t Profiler::zone_count() const
+{
+    std::lock_guard lock(m_mutex);
+    size_t n = 0;
+    for (const auto& r : m_rings)
+    {
+        const uint64_t end = r->published.load(std::memory_order_acquire);
+        n += end - std::max(end > kRingCapacity ? end - kRingCapacity : 0, r->cleared.load(std::memory_order_relaxed));
+    }
+    return n;
+}
+
+void Profiler::clear()
+{
+    std::lock_guard lock(m_mutex);
+    for (auto& r : m_rings) r->cleared.store(r->published.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+namespace
+{
+    void write_json_string(std::FILE* f, const char* s)
+    {
+        std::fputc('"', f);
+        for (; s && *s; ++s)
+        {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') { std::fputc('\\', f); std::fputc(c, f); }
+            else if (c < 0x20) std::fprintf(f, "\\u%04x", c);
+            else std::fputc(c, f);
+        }
+        std::fputc('"', f);
+    }
+}
+
+bool Profiler::write_chrome_trace(const std::string& path) const
+{
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::lock_guard lock(m_mutex);
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", f);
+    bool first = true;
+    auto separator = [&] { if (!first) std::fputs(",\n", f); first = false; };
+
+    for (const auto& [tid, name] : m_thread_names)
+    {
+        separator();
+        std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", tid);
+        write_json_string(f, name.c_str());
+        std::fputs("}}", f);
+    }
+
+    // Complete ("X") events in microseconds since the profiler started
+    for (const auto& r : m_rings)
+    {
+        for (const Zone& z : snapshot(*r))
+        {
+            separator();
+            std::fputs("{\"name\":", f);
+            write_json_string(f, z.name);
+            const double ts = static_cast<double>(static_cast<int64_t>(z.start_ns - m_epoch_ns)) * 1e-3;
+            const double dur = static_cast<double>(z.end_ns - z.start_ns) * 1e-3;
+            std::fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", r->tid, ts, dur);
+        }
+    }
+    std::fputs("]}\n", f);
+    return std::fclose(f) == 0;
+}
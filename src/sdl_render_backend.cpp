@@ -0,0 +1,65 @@
+#include "sdl_render_backend.hpp"
+#include <SDL3_image/SDL_image.h>
+#include <cstddef>
+#include "geometry_batch.hpp"
+
+// The core's vertex types are submitted to SDL as-is
+static_assert(sizeof(Vertex) == sizeof(SDL_Vertex) && offsetof(Vertex, color) == offsetof(SDL_Vertex, color) &&
+              offsetof(Vertex, tex_coord) == offsetof(SDL_Vertex, tex_coord), "Vertex must match SDL_Vertex");
+static_assert(sizeof(Color) == sizeof(SDL_Color), "Color must match SDL_Color");
+
+SdlRenderBackend::SdlRenderBackend(SDL_Renderer* renderer)
+    : m_renderer(renderer)
+{
+    // Indices are relative to the vertex pointer of each draw call, so one chunk's
+    // pattern serves every chunk
+    m_indices.resize(GeometryBatch::kQuadsPerDraw * 6);
+    for (size_t q = 0; q < GeometryBatch::kQuadsPerDraw; ++q)
+    {
+        const int v = static_cast<int>(q * 4);
+        int* i = &m_indices[q * 6];
+        i[0] = v; i[1] = v + 1; i[2] = v + 2;
+        i[3] = v; i[4] = v + 2; i[5] = v + 3;
+    }
+}
+
+SdlRenderBackend::~SdlRenderBackend()
+{
+    for (SDL_Texture* texture : m_textures) SDL_DestroyTexture(texture);
+}
+
+void SdlRenderBackend::draw_quads(const Vertex* vertices, size_t quads, TextureId texture)
+{
+    SDL_RenderGeometry(m_renderer, static_cast<SDL_Texture*>(texture), reinterpret_cast<const SDL_Vertex*>(vertices),
+                       static_cast<int>(quads * 4), m_indices.data(), static_cast<int>(quads * 6));
+}
+
+void SdlRenderBackend::fill_rect(float x, float y, float w, float h, Color color)
+{
+    const SDL_FRect rect{ x, y, w, h };
+    SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(m_renderer, &rect);
+}
+
+std::unique_ptr<SpriteAtlas> SdlRenderBackend::load_atlas(const std::string& path, int frame_width, int frame_height)
+{
+    SDL_Surface* surface = IMG_Load(path.c_str());
+    if (!surface) { SDL_Log("Sprite atlas '%s' failed to load: %s", path.c_str(), SDL_GetError()); return nullptr; }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+    SDL_DestroySurface(surface);
+    if (!texture) { SDL_Log("Sprite atlas '%s' texture creation failed: %s", path.c_str(), SDL_GetError()); return nullptr; }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    float width = 0.0f, height = 0.0f;
+    SDL_GetTextureSize(texture, &width, &height);
+    auto atlas = std::make_unique<SpriteAtlas>(texture, width, height, frame_width, frame_height);
+    if (atlas->frames() == 0)
+    {
+        SDL_Log("Sprite atlas '%s' (%gx%g) is smaller than one %dx%d frame", path.c_str(), width, height, frame_width, frame_height);
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    m_textures.push_back(texture);
+    return atlas;
+}
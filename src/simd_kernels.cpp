@@ -0,0 +1,349 @@
+#include "simd_kernels.hpp"
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICULATE_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Per-function target attributes let AVX variants live in a baseline build
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARTICULATE_HAS_AVX_DISPATCH 1
+#include <immintrin.h>
+#define PARTICULATE_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace
+{
+    using IntegrateFn = void (*)(float*, float*, float*, float*, size_t, const IntegrateParams&);
+    using CullFn = size_t (*)(const float*, const float*, const float*, const float*, const float*,
+                              size_t, const CullParams&, uint32_t, uint32_t*);
+
+    // Dispatch table for the active variant; add future hot loops here.
+    struct KernelTable
+    {
+        SimdLevel level;
+        IntegrateFn integrate;
+        CullFn cull;
+    };
+
+    KernelTable table_for(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::AVX512: return { level, &integrate_avx512, &cull_avx512 };
+        case SimdLevel::AVX2:   return { level, &integrate_avx2, &cull_avx2 };
+        case SimdLevel::SSE2:   return { level, &integrate_sse2, &cull_sse2 };
+        default:                return { SimdLevel::Scalar, &integrate_scalar, &cull_scalar };
+        }
+    }
+
+    bool supported(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar: return true;
+#ifdef PARTICULATE_HAS_SSE2
+        case SimdLevel::SSE2: return true;
+#endif
+#ifdef PARTICULATE_HAS_AVX_DISPATCH
+        case SimdLevel::AVX2: return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+#endif
+        default: return false;
+        }
+    }
+
+#ifdef PARTICULATE_HAS_SSE2
+    // Lane offsets of the set bits of a 4-bit mask, packed to the front
+    struct CompressLut
+    {
+        uint32_t lane[16][4];
+        uint32_t count[16];
+
+        constexpr CompressLut() : lane(), count()
+        {
+            for (uint32_t m = 0; m < 16; ++m)
+                for (uint32_t b = 0; b < 4; ++b)
+                    if (m & (1u << b)) lane[m][count[m]++] = b;
+        }
+    };
+    constexpr CompressLut kCompress;
+
+    // Append base + i + lane for each set bit of the 4-bit mask. Writes 4 slots
+    // unconditionally; safe because the output never runs ahead of the input.
+    inline size_t compress4(uint32_t* out, size_t k, uint32_t first, int mask)
+    {
+        const uint32_t* lane = kCompress.lane[mask];
+        out[k] = first + lane[0]; out[k + 1] = first + lane[1];
+        out[k + 2] = first + lane[2]; out[k + 3] = first + lane[3];
+        return k + kCompress.count[mask];
+    }
+#endif
+
+    KernelTable& active_table()
+    {
+        static KernelTable table = table_for(detect_simd_level());
+        return table;
+    }
+}
+
+IntegrateParams IntegrateParams::make(float gravity_x, float gravity_y, float damping, float dt)
+{
+    float factor = 1.0f;
+    if (damping > 0.0f)
+    {
+        factor = 1.0f - damping * dt;
+        if (factor < 0.0f) factor = 0.0f;
+    }
+    return { gravity_x * dt, gravity_y * dt, factor, dt };
+}
+
+const char* simd_level_name(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE2:   return "sse2";
+    case SimdLevel::AVX2:   return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    default:                return "scalar";
+    }
+}
+
+bool parse_simd_level(const std::string& name, SimdLevel& level)
+{
+    for (SimdLevel l : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+    {
+        if (name == simd_level_name(l)) { level = l; return true; }
+    }
+    return false;
+}
+
+SimdLevel detect_simd_level()
+{
+#ifdef PARTICULATE_HAS_AVX_DISPATCH
+    __builtin_cpu_init();
+#endif
+    for (SimdLevel l : { SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2 })
+        if (supported(l)) return l;
+    return SimdLevel::Scalar;
+}
+
+SimdLevel configure_simd_kernels(const std::string& requested, std::string& warning)
+{
+    SimdLevel level = detect_simd_level();
+    SimdLevel forced;
+    warning.clear();
+    if (parse_simd_level(requested, forced))
+    {
+        if (supported(forced)) level = forced;
+        else warning = "simd_kernel '" + requested + "' is not supported by this CPU, using " + simd_level_name(level);
+    }
+    else if (requested != "auto")
+    {
+        warning = "Unknown simd_kernel '" + requested + "', using " + simd_level_name(level);
+    }
+
+    active_table() = table_for(level);
+    return level;
+}
+
+SimdLevel active_simd_level() { return active_table().level; }
+
+void integrate(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p)
+{
+    active_table().integrate(x, y, vx, vy, n, p);
+}
+
+void integrate_scalar(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        float nvx = (vx[i] + p.gx_dt) * p.damping_factor;
+        float nvy = (vy[i] + p.gy_dt) * p.damping_factor;
+        vx[i] = nvx;
+        vy[i] = nvy;
+        x[i] += nvx * p.dt;
+        y[i] += nvy * p.dt;
+    }
+}
+
+void integrate_sse2(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p)
+{
+#ifdef PARTICULATE_HAS_SSE2
+    const __m128 gx = _mm_set1_ps(p.gx_dt);
+    const __m128 gy = _mm_set1_ps(p.gy_dt);
+    const __m128 f = _mm_set1_ps(p.damping_factor);
+    const __m128 dt = _mm_set1_ps(p.dt);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 nvx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vx + i), gx), f);
+        __m128 nvy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vy + i), gy), f);
+        _mm_storeu_ps(vx + i, nvx);
+        _mm_storeu_ps(vy + i, nvy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(nvx, dt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(nvy, dt)));
+    }
+    integrate_scalar(x + i, y + i, vx + i, vy + i, n - i, p); // tail
+#else
+    integrate_scalar(x, y, vx, vy, n, p);
+#endif
+}
+
+size_t cull(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+            size_t n, const CullParams& p, uint32_t base, uint32_t* out)
+{
+    return active_table().cull(x, y, prev_x, prev_y, radius, n, p, base, out);
+}
+
+size_t cull_scalar(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                   size_t n, const CullParams& p, uint32_t base, uint32_t* out)
+{
+    const float beta = 1.0f - p.alpha;
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Branchless append: always write, advance only when visible
+        const float px = x[i] * p.alpha + prev_x[i] * beta;
+        const float py = y[i] * p.alpha + prev_y[i] * beta;
+        const float r = radius[i];
+        const bool visible = (px + r >= p.min_x) & (px - r <= p.max_x) & (py + r >= p.min_y) & (py - r <= p.max_y);
+        out[k] = base + static_cast<uint32_t>(i);
+        k += visible;
+    }
+    return k;
+}
+
+size_t cull_sse2(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                 size_t n, const CullParams& p, uint32_t base, uint32_t* out)
+{
+#ifdef PARTICULATE_HAS_SSE2
+    const __m128 a = _mm_set1_ps(p.alpha);
+    const __m128 b = _mm_set1_ps(1.0f - p.alpha);
+    const __m128 min_x = _mm_set1_ps(p.min_x), max_x = _mm_set1_ps(p.max_x);
+    const __m128 min_y = _mm_set1_ps(p.min_y), max_y = _mm_set1_ps(p.max_y);
+
+    size_t i = 0, k = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 px = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), a), _mm_mul_ps(_mm_loadu_ps(prev_x + i), b));
+        const __m128 py = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(y + i), a), _mm_mul_ps(_mm_loadu_ps(prev_y + i), b));
+        const __m128 r = _mm_loadu_ps(radius + i);
+        __m128 in = _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(px, r), min_x), _mm_cmple_ps(_mm_sub_ps(px, r), max_x));
+        in = _mm_and_ps(in, _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(py, r), min_y), _mm_cmple_ps(_mm_sub_ps(py, r), max_y)));
+        k = compress4(out, k, base + static_cast<uint32_t>(i), _mm_movemask_ps(in));
+    }
+    return k + cull_scalar(x + i, y + i, prev_x + i, prev_y + i, radius + i, n - i, p, base + static_cast<uint32_t>(i), out + k);
+#else
+    return cull_scalar(x, y, prev_x, prev_y, radius, n, p, base, out);
+#endif
+}
+
+#ifdef PARTICULATE_HAS_AVX_DISPATCH
+
+PARTICULATE_TARGET("avx2")
+void integrate_avx2(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p)
+{
+    const __m256 gx = _mm256_set1_ps(p.gx_dt);
+    const __m256 gy = _mm256_set1_ps(p.gy_dt);
+    const __m256 f = _mm256_set1_ps(p.damping_factor);
+    const __m256 dt = _mm256_set1_ps(p.dt);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 nvx = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(vx + i), gx), f);
+        __m256 nvy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(vy + i), gy), f);
+        _mm256_storeu_ps(vx + i, nvx);
+        _mm256_storeu_ps(vy + i, nvy);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(nvx, dt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(nvy, dt)));
+    }
+    integrate_sse2(x + i, y + i, vx + i, vy + i, n - i, p); // tail
+}
+
+PARTICULATE_TARGET("avx512f")
+void integrate_avx512(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p)
+{
+    const __m512 gx = _mm512_set1_ps(p.gx_dt);
+    const __m512 gy = _mm512_set1_ps(p.gy_dt);
+    const __m512 f = _mm512_set1_ps(p.damping_factor);
+    const __m512 dt = _mm512_set1_ps(p.dt);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512 nvx = _mm512_mul_ps(_mm512_add_ps(_mm512_loadu_ps(vx + i), gx), f);
+        __m512 nvy = _mm512_mul_ps(_mm512_add_ps(_mm512_loadu_ps(vy + i), gy), f);
+        _mm512_storeu_ps(vx + i, nvx);
+        _mm512_storeu_ps(vy + i, nvy);
+        _mm512_storeu_ps(x + i, _mm512_add_ps(_mm512_loadu_ps(x + i), _mm512_mul_ps(nvx, dt)));
+        _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_mul_ps(nvy, dt)));
+    }
+    integrate_sse2(x + i, y + i, vx + i, vy + i, n - i, p); // tail
+}
+
+PARTICULATE_TARGET("avx2")
+size_t cull_avx2(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                 size_t n, const CullParams& p, uint32_t base, uint32_t* out)
+{
+    const __m256 a = _mm256_set1_ps(p.alpha);
+    const __m256 b = _mm256_set1_ps(1.0f - p.alpha);
+    const __m256 min_x = _mm256_set1_ps(p.min_x), max_x = _mm256_set1_ps(p.max_x);
+    const __m256 min_y = _mm256_set1_ps(p.min_y), max_y = _mm256_set1_ps(p.max_y);
+
+    size_t i = 0, k = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 px = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), a), _mm256_mul_ps(_mm256_loadu_ps(prev_x + i), b));
+        const __m256 py = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(y + i), a), _mm256_mul_ps(_mm256_loadu_ps(prev_y + i), b));
+        const __m256 r = _mm256_loadu_ps(radius + i);
+        __m256 in = _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(px, r), min_x, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_sub_ps(px, r), max_x, _CMP_LE_OQ));
+        in = _mm256_and_ps(in, _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(py, r), min_y, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_sub_ps(py, r), max_y, _CMP_LE_OQ)));
+        const int mask = _mm256_movemask_ps(in);
+        k = compress4(out, k, base + static_cast<uint32_t>(i), mask & 0xF);
+        k = compress4(out, k, base + static_cast<uint32_t>(i + 4), mask >> 4);
+    }
+    return k + cull_sse2(x + i, y + i, prev_x + i, prev_y + i, radius + i, n - i, p, base + static_cast<uint32_t>(i), out + k);
+}
+
+PARTICULATE_TARGET("avx512f")
+size_t cull_avx512(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                   size_t n, const CullParams& p, uint32_t base, uint32_t* out)
+{
+    const __m512 a = _mm512_set1_ps(p.alpha);
+    const __m512 b = _mm512_set1_ps(1.0f - p.alpha);
+    const __m512 min_x = _mm512_set1_ps(p.min_x), max_x = _mm512_set1_ps(p.max_x);
+    const __m512 min_y = _mm512_set1_ps(p.min_y), max_y = _mm512_set1_ps(p.max_y);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    size_t i = 0, k = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512 px = _mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(x + i), a), _mm512_mul_ps(_mm512_loadu_ps(prev_x + i), b));
+        const __m512 py = _mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(y + i), a), _mm512_mul_ps(_mm512_loadu_ps(prev_y + i), b));
+        const __m512 r = _mm512_loadu_ps(radius + i);
+        __mmask16 in = _mm512_cmp_ps_mask(_mm512_add_ps(px, r), min_x, _CMP_GE_OQ);
+        in = _mm512_mask_cmp_ps_mask(in, _mm512_sub_ps(px, r), max_x, _CMP_LE_OQ);
+        in = _mm512_mask_cmp_ps_mask(in, _mm512_add_ps(py, r), min_y, _CMP_GE_OQ);
+        in = _mm512_mask_cmp_ps_mask(in, _mm512_sub_ps(py, r), max_y, _CMP_LE_OQ);
+        const __m512i idx = _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(base + static_cast<uint32_t>(i))));
+        _mm512_mask_compressstoreu_epi32(out + k, in, idx);
+        k += static_cast<size_t>(__builtin_popcount(in));
+    }
+    return k + cull_sse2(x + i, y + i, prev_x + i, prev_y + i, radius + i, n - i, p, base + static_cast<uint32_t>(i), out + k);
+}
+
+#else
+
+// Not dispatchable on this target; never selected (supported() is false)
+void integrate_avx2(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p) { integrate_sse2(x, y, vx, vy, n, p); }
+void integrate_avx512(float* x, float* y, float* vx, float* vy, size_t n, const IntegrateParams& p) { integrate_sse2(x, y, vx, vy, n, p); }
+size_t cull_avx2(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                 size_t n, const CullParams& p, uint32_t base, uint32_t* out) { return cull_sse2(x, y, prev_x, prev_y, radius, n, p, base, out); }
+size_t cull_avx512(const float* x, const float* y, const float* prev_x, const float* prev_y, const float* radius,
+                   size_t n, const CullParams& p, uint32_t base, uint32_t* out) { return cull_sse2(x, y, prev_x, prev_y, radius, n, p, base, out); }
+
+#endif
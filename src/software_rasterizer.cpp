@@ -0,0 +1,263 @@
+#include "software_rasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICULATE_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t kBinChunk = 4096; // quads per binning task
+    constexpr int kTilePixels = SoftwareRasterizer::kTileSize * SoftwareRasterizer::kTileSize;
+
+    // Shape recovered from a GeometryBatch quad (see GeometryBatch::write_quad):
+    // axis-aligned, corners 0 and 2 opposite. Discs use hw as their radius.
+    struct Shape
+    {
+        float cx, cy, hw, hh;
+        FColor color;
+        QuadShape kind;
+    };
+
+    Shape shape_of(const GeometryBatch& batch, size_t quad)
+    {
+        const Vertex* v = batch.vertices() + quad * 4;
+        return { (v[0].position.x + v[2].position.x) * 0.5f, (v[0].position.y + v[2].position.y) * 0.5f,
+                 (v[2].position.x - v[0].position.x) * 0.5f, (v[2].position.y - v[0].position.y) * 0.5f,
+                 v[0].color, batch.shapes()[quad] };
+    }
+
+    // Pixel bounds touched by a shape (a disc's anti-aliased edge reaches half a pixel
+    // further), clamped to [0, w) x [0, h); false if empty
+    bool pixel_bounds(const Shape& s, int w, int h, int& x0, int& y0, int& x1, int& y1)
+    {
+        const bool disc = s.kind == QuadShape::Disc;
+        const float rx = disc ? std::max(s.hw, 0.5f) + 0.5f : s.hw;
+        const float ry = disc ? rx : s.hh;
+        if (!(s.cx + rx > 0.0f && s.cy + ry > 0.0f && s.cx - rx < static_cast<float>(w) && s.cy - ry < static_cast<float>(h)))
+            return false; // off screen (or NaN)
+        x0 = std::max(static_cast<int>(std::floor(s.cx - rx)), 0);
+        y0 = std::max(static_cast<int>(std::floor(s.cy - ry)), 0);
+        x1 = std::min(static_cast<int>(std::ceil(s.cx + rx)), w);
+        y1 = std::min(static_cast<int>(std::ceil(s.cy + ry)), h);
+        return x0 < x1 && y0 < y1;
+    }
+
+    // Covered fraction of the unit pixel span [p, p + 1] by [lo, hi]
+    float span_coverage(float p, float lo, float hi) { return std::clamp(std::min(p + 1.0f, hi) - std::max(p, lo), 0.0f, 1.0f); }
+
+    // Blend an axis-aligned rectangle into a tile's float planes over tile-local pixels
+    // [x0, x1) x [y0, y1), weighting each pixel by the area the rectangle covers.
+    void fill(float* pr, float* pg, float* pb, const Shape& s, float ox, float oy, int x0, int y0, int x1, int y1)
+    {
+        constexpr int T = SoftwareRasterizer::kTileSize;
+        const float left = s.cx - s.hw - ox, right = s.cx + s.hw - ox;
+        const float top = s.cy - s.hh - oy, bottom = s.cy + s.hh - oy;
+
+        for (int y = y0; y < y1; ++y)
+        {
+            const float ay = span_coverage(static_cast<float>(y), top, bottom) * s.color.a;
+            float* rr = pr + y * T;
+            float* rg = pg + y * T;
+            float* rb = pb + y * T;
+            for (int x = x0; x < x1; ++x)
+            {
+                const float a = span_coverage(static_cast<float>(x), left, right) * ay;
+                rr[x] += (s.color.r - rr[x]) * a;
+                rg[x] += (s.color.g - rg[x]) * a;
+                rb[x] += (s.color.b - rb[x]) * a;
+            }
+        }
+    }
+
+    // Blend one disc into a tile's float planes over tile-local pixels [x0, x1) x [y0, y1).
+    // Coverage is 1 inside r - 0.5, 0 outside r + 0.5 and linear across the edge pixel;
+    // discs smaller than a pixel are drawn half a pixel wide with alpha scaled by area.
+    void splat(float* pr, float* pg, float* pb, const Shape& c, float ox, float oy, int x0, int y0, int x1, int y1)
+    {
+        constexpr int T = SoftwareRasterizer::kTileSize;
+        const float r = std::max(c.hw, 0.5f);
+        const float alpha = c.color.a * (c.hw < 0.5f ? (c.hw * c.hw) * 4.0f : 1.0f);
+        const float edge = r + 0.5f;
+        const float cx = c.cx - ox - 0.5f; // pixel centers sit at +0.5
+        const float cy = c.cy - oy - 0.5f;
+
+        // Whole 4-pixel groups; extra pixels at either end lie outside the edge and get zero coverage
+        x0 &= ~3;
+        x1 = std::min((x1 + 3) & ~3, T);
+
+        for (int y = y0; y < y1; ++y)
+        {
+            const float dy = static_cast<float>(y) - cy;
+            const float dy2 = dy * dy;
+            float* rr = pr + y * T;
+            float* rg = pg + y * T;
+            float* rb = pb + y * T;
+#ifdef PARTICULATE_HAS_SSE2
+            const __m128 vdy2 = _mm_set1_ps(dy2), vedge = _mm_set1_ps(edge), valpha = _mm_set1_ps(alpha);
+            const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+            const __m128 cr = _mm_set1_ps(c.color.r), cg = _mm_set1_ps(c.color.g), cb = _mm_set1_ps(c.color.b);
+            __m128 dx = _mm_sub_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps(cx - static_cast<float>(x0)));
+            const __m128 four = _mm_set1_ps(4.0f);
+            for (int x = x0; x < x1; x += 4, dx = _mm_add_ps(dx, four))
+            {
+                const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), vdy2));
+                const __m128 a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_sub_ps(vedge, dist), zero), one), valpha);
+                const __m128 r4 = _mm_load_ps(rr + x), g4 = _mm_load_ps(rg + x), b4 = _mm_load_ps(rb + x);
+                _mm_store_ps(rr + x, _mm_add_ps(r4, _mm_mul_ps(_mm_sub_ps(cr, r4), a)));
+                _mm_store_ps(rg + x, _mm_add_ps(g4, _mm_mul_ps(_mm_sub_ps(cg, g4), a)));
+                _mm_store_ps(rb + x, _mm_add_ps(b4, _mm_mul_ps(_mm_sub_ps(cb, b4), a)));
+            }
+#else
+            for (int x = x0; x < x1; ++x)
+            {
+                const float dx = static_cast<float>(x) - cx;
+                const float a = std::clamp(edge - std::sqrt(dx * dx + dy2), 0.0f, 1.0f) * alpha;
+                rr[x] += (c.color.r - rr[x]) * a;
+                rg[x] += (c.color.g - rg[x]) * a;
+                rb[x] += (c.color.b - rb[x]) * a;
+            }
+#endif
+        }
+    }
+
+    uint32_t pack(float r, float g, float b)
+    {
+        auto to8 = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return 0xFF000000u | (to8(r) << 16) | (to8(g) << 8) | to8(b);
+    }
+
+    template <typename F>
+    void for_range(ThreadPool* pool, size_t count, F&& f)
+    {
+        if (pool) pool->parallel_for(count, 1, [&f](size_t begin, size_t end) { for (size_t i = begin; i < end; ++i) f(i); });
+        else for (size_t i = 0; i < count; ++i) f(i);
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(ThreadPool* thread_pool)
+    : m_thread_pool(thread_pool)
+{}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+    if (m_texture) SDL_DestroyTexture(m_texture);
+}
+
+void SoftwareRasterizer::resize(SDL_Renderer* renderer, int width, int height)
+{
+    if (m_texture && width == m_width && height == m_height && renderer == m_texture_renderer) return;
+
+    if (m_texture) SDL_DestroyTexture(m_texture);
+    m_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!m_texture) { SDL_Log("Software rasterizer: texture creation failed: %s", SDL_GetError()); return; }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(m_texture, SDL_SCALEMODE_NEAREST);
+    m_texture_renderer = renderer;
+
+    m_width = width;
+    m_height = height;
+    m_tiles_x = (width + kTileSize - 1) / kTileSize;
+    m_tiles_y = (height + kTileSize - 1) / kTileSize;
+    m_framebuffer.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0xFF000000u);
+    m_tile_begin.resize(static_cast<size_t>(m_tiles_x * m_tiles_y) + 1);
+}
+
+void SoftwareRasterizer::bin(const GeometryBatch& batch)
+{
+    const size_t quads = batch.quads();
+    const size_t tiles = static_cast<size_t>(m_tiles_x * m_tiles_y);
+    const size_t chunks = (quads + kBinChunk - 1) / kBinChunk;
+
+    // Calls f(tile) for every tile quad q touches
+    auto for_each_tile = [&](size_t q, auto&& f)
+    {
+        int x0, y0, x1, y1;
+        if (!pixel_bounds(shape_of(batch, q), m_width, m_height, x0, y0, x1, y1)) return;
+        for (int ty = y0 / kTileSize; ty <= (y1 - 1) / kTileSize; ++ty)
+            for (int tx = x0 / kTileSize; tx <= (x1 - 1) / kTileSize; ++tx)
+                f(static_cast<size_t>(ty * m_tiles_x + tx));
+    };
+
+    // Pass 1: per-chunk tile counts
+    m_chunk_counts.assign(chunks * tiles, 0);
+    for_range(m_thread_pool, chunks, [&](size_t chunk)
+    {
+        uint32_t* counts = m_chunk_counts.data() + chunk * tiles;
+        const size_t end = std::min((chunk + 1) * kBinChunk, quads);
+        for (size_t q = chunk * kBinChunk; q < end; ++q) for_each_tile(q, [&](size_t t) { ++counts[t]; });
+    });
+
+    // Exclusive scan, tile-major then chunk, so each tile's entries stay in submission order
+    uint32_t total = 0;
+    for (size_t t = 0; t < tiles; ++t)
+    {
+        m_tile_begin[t] = total;
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            uint32_t& c = m_chunk_counts[chunk * tiles + t];
+            const uint32_t count = c;
+            c = total;
+            total += count;
+        }
+    }
+    m_tile_begin[tiles] = total;
+    m_bins.resize(total);
+
+    // Pass 2: fill
+    for_range(m_thread_pool, chunks, [&](size_t chunk)
+    {
+        uint32_t* offsets = m_chunk_counts.data() + chunk * tiles;
+        const size_t end = std::min((chunk + 1) * kBinChunk, quads);
+        for (size_t q = chunk * kBinChunk; q < end; ++q)
+            for_each_tile(q, [&](size_t t) { m_bins[offsets[t]++] = static_cast<uint32_t>(q); });
+    });
+}
+
+void SoftwareRasterizer::rasterize_tile(const GeometryBatch& batch, size_t tile, SDL_Color background)
+{
+    alignas(16) float pr[kTilePixels];
+    alignas(16) float pg[kTilePixels];
+    alignas(16) float pb[kTilePixels];
+    std::fill_n(pr, kTilePixels, background.r / 255.0f);
+    std::fill_n(pg, kTilePixels, background.g / 255.0f);
+    std::fill_n(pb, kTilePixels, background.b / 255.0f);
+
+    const int ox = static_cast<int>(tile % static_cast<size_t>(m_tiles_x)) * kTileSize;
+    const int oy = static_cast<int>(tile / static_cast<size_t>(m_tiles_x)) * kTileSize;
+    const int tw = std::min(kTileSize, m_width - ox);
+    const int th = std::min(kTileSize, m_height - oy);
+
+    for (uint32_t k = m_tile_begin[tile]; k < m_tile_begin[tile + 1]; ++k)
+    {
+        const Shape s = shape_of(batch, m_bins[k]);
+        int x0, y0, x1, y1;
+        if (!pixel_bounds(s, m_width, m_height, x0, y0, x1, y1)) continue;
+        x0 = std::max(x0 - ox, 0); x1 = std::min(x1 - ox, tw);
+        y0 = std::max(y0 - oy, 0); y1 = std::min(y1 - oy, th);
+        if (!(x0 < x1 && y0 < y1)) continue;
+        if (s.kind == QuadShape::Disc) splat(pr, pg, pb, s, static_cast<float>(ox), static_cast<float>(oy), x0, y0, x1, y1);
+        else fill(pr, pg, pb, s, static_cast<float>(ox), static_cast<float>(oy), x0, y0, x1, y1);
+    }
+
+    for (int y = 0; y < th; ++y)
+    {
+        uint32_t* row = m_framebuffer.data() + static_cast<size_t>(oy + y) * static_cast<size_t>(m_width) + static_cast<size_t>(ox);
+        for (int x = 0; x < tw; ++x) row[x] = pack(pr[y * kTileSize + x], pg[y * kTileSize + x], pb[y * kTileSize + x]);
+    }
+}
+
+void SoftwareRasterizer::draw(const GeometryBatch& batch, SDL_Renderer* renderer, int width, int height, SDL_Color background)
+{
+    if (width <= 0 || height <= 0) return;
+    resize(renderer, width, height);
+    if (!m_texture) return;
+
+    bin(batch);
+    for_range(m_thread_pool, static_cast<size_t>(m_tiles_x * m_tiles_y), [&](size_t tile) { rasterize_tile(batch, tile, background); });
+
+    SDL_UpdateTexture(m_texture, nullptr, m_framebuffer.data(), m_width * static_cast<int>(sizeof(uint32_t)));
+    SDL_RenderTexture(renderer, m_texture, nullptr, nullptr);
+}
@@ -0,0 +1,17 @@
+#include "sprite_atlas.hpp"
+
+SpriteAtlas::SpriteAtlas(TextureId texture, float texture_width, float texture_height, int frame_width, int frame_height)
+    : m_texture(texture)
+{
+    const float fw = frame_width > 0 ? static_cast<float>(frame_width) : texture_width;
+    const float fh = frame_height > 0 ? static_cast<float>(frame_height) : texture_height;
+    if (fw <= 0.0f || fh <= 0.0f) return;
+    const int cols = static_cast<int>(texture_width / fw);
+    const int rows = static_cast<int>(texture_height / fh);
+    if (cols <= 0 || rows <= 0) return;
+
+    m_uvs.reserve(static_cast<size_t>(cols * rows));
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            m_uvs.push_back({ c * fw / texture_width, r * fh / texture_height, (c + 1) * fw / texture_width, (r + 1) * fh / texture_height });
+}
@@ -1,10 +1,14 @@
 #include "state.hpp"
 #include <SDL3/SDL_version.h>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <memory>
 #include <random>
 #include "particle_system.hpp"
 #include "simple_particle.hpp"
+#include "sprite_particle.hpp"
+#include "simd_kernels.hpp"
 
 State::State()
 {
@@ -22,6 +26,8 @@ State::State()
     }
 
     const Config& config = Config::get_instance();
+    PROFILE_THREAD("main");
+    if (config.is_profiler()) Profiler::get_instance().set_enabled(true);
 
     window = SDL_CreateWindow("Ferl", config.get_window_width(), config.get_window_height(), static_cast<SDL_WindowFlags>(config.get_window_flags()));
     if (!window) { throw std::runtime_error(std::string("Window initialization failed: ") + SDL_GetError()); }
@@ -30,23 +36,50 @@ State::State()
 
     renderer = SDL_CreateRenderer(window, nullptr);
     if (!renderer) { throw std::runtime_error(std::string("Renderer initialization failed: ") + SDL_GetError( )); }
-    uint32_t rflags = config.get_renderer_flags();
-    #ifdef SDL_RENDERER_PRESENTVSYNC
-    if (rflags & SDL_RENDERER_PRESENTVSYNC) { SDL_SetRenderVSync(renderer, 1); }
-    #endif
+    sdl_backend = std::make_unique<SdlRenderBackend>(renderer);
 
-    delta_time = Config::get_instance().get_target_frame_delta();
-    last_frame_time = SDL_GetTicksNS();
+    // With vsync SDL_RenderPresent paces the loop and the pacer only measures
+    bool vsync = config.get_vsync() != 0 && SDL_SetRenderVSync(renderer, config.get_vsync());
+    if (config.get_vsync() != 0 && !vsync) SDL_Log("VSync %d unavailable (%s), pacing with timers", config.get_vsync(), SDL_GetError());
+    frame_pacer.set_target_fps(vsync ? 0.0 : static_cast<double>(config.get_fps()));
+
+    if (config.get_render_backend() == "software") software_rasterizer = std::make_unique<SoftwareRasterizer>(&thread_pool);
+    else if (config.get_render_backend() != "sdl") SDL_Log("Unknown render_backend '%s', using sdl", config.get_render_backend().c_str());
+
+    density_view = config.get_render_mode() == "density";
+    DensityRenderer::Weight weight;
+    if (DensityRenderer::parse_weight(config.get_density_weight(), weight)) density_renderer.set_weight(weight);
+    else SDL_Log("Unknown density_weight '%s', using count", config.get_density_weight().c_str());
+
+    std::string simd_warning;
+    SimdLevel simd = configure_simd_kernels(config.get_simd_kernel(), simd_warning);
+    if (!simd_warning.empty()) SDL_Log("%s", simd_warning.c_str());
+    SDL_Log("Simulation kernels: %s (requested %s, cpu supports %s)", simd_level_name(simd),
+            config.get_simd_kernel().c_str(), simd_level_name(detect_simd_level()));
+
+    delta_time = Config::get_instance().get_target_frame_delta() / 1000.0f; // ms -> seconds
 
     // Camera is in world coordinates (centered on origin by default).
     camera.x = 0.0f; camera.y = 0.0f; camera.z = 0.0f;
 
     setup_scene();
+    build_frame_graph();
+
+    threaded_simulation = config.is_threaded_simulation();
+    if (threaded_simulation) simulation_thread = std::thread(&State::simulation_loop, this);
 }
 
 State::~State()
 {
-    // No managed textures in particle sandbox
+    simulation_stop.store(true);
+    if (simulation_thread.joinable()) simulation_thread.join();
+    log_frame_pacing();
+    if (Profiler::enabled()) write_profile();
+
+    software_rasterizer.reset(); // textures belong to the renderer
+    density_renderer.release();
+    sprite_atlas.reset();
+    sdl_backend.reset();          // and the atlas textures it loaded
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
@@ -58,18 +91,135 @@ State& State::get_instance()
     return instance;
 }
 
+void State::build_frame_graph()
+{
+    using Affinity = TaskGraph::Affinity;
+    // SDL event and render calls must stay on the main thread
+    TaskGraph::StageId input = frame_graph.add("input", [this] { process_input(); }, {}, Affinity::Caller);
+    if (config.is_threaded_simulation())
+    {
+        frame_graph.add("render", [this] { render(); }, { input }, Affinity::Caller);
+        return;
+    }
+    TaskGraph::StageId simulate = frame_graph.add("simulate", [this] { update(); });
+    frame_graph.add("render", [this] { render(); }, { input, simulate }, Affinity::Caller);
+}
+
+void State::simulation_loop()
+{
+    // Fixed steps at sim_rate, independent of presentation. Steps that came due while
+    // the thread was late are caught up (at most max_sim_steps per wake), then one
+    // snapshot is published.
+    const float step = config.get_sim_step();
+    const int max_steps = std::max(config.get_max_sim_steps(), 1);
+    const auto period = std::chrono::nanoseconds(static_cast<long long>(static_cast<double>(step) * 1e9));
+    auto next = std::chrono::steady_clock::now() + period;
+    PROFILE_THREAD("simulation");
+
+    while (!simulation_stop.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_until(next);
+        const auto now = std::chrono::steady_clock::now();
+        int steps = 0;
+        for (; next <= now && steps < max_steps; ++steps, next += period)
+            particle_system.update(SimParams::from_config(config, step));
+        if (next <= now) next = now + period; // too far behind: drop the backlog
+
+        ParticleSnapshot& snapshot = snapshots.write_buffer();
+        particle_system.snapshot(snapshot);
+        snapshot.published_ns = SDL_GetTicksNS();
+        snapshots.publish();
+    }
+}
+
+void State::run_frame()
+{
+    frame_graph.run(&thread_pool);
+    if (config.is_debug_overlay() && config.get_fps() > 0 && ++frame_count % static_cast<Uint64>(config.get_fps()) == 0) log_frame_timings();
+    delay();
+}
+
+void State::log_frame_timings()
+{
+    SDL_Log("Frame graph %.3f ms", frame_graph.total_ms());
+    for (size_t i = 0; i < frame_graph.size(); ++i)
+        SDL_Log("  %-10s start %7.3f ms  took %7.3f ms", frame_graph.name(i).c_str(), frame_graph.start_ms(i), frame_graph.duration_ms(i));
+
+    if (threaded_simulation)
+    {
+        // The simulation thread rewrites updateGraph() while this runs; log the copy published with the snapshot
+        for (const ParticleSnapshot::StageTiming& stage : snapshots.read().update_stages)
+            SDL_Log("    %-24s start %7.3f ms  took %7.3f ms", stage.name.c_str(), stage.start_ms, stage.duration_ms);
+    }
+    else
+    {
+        const TaskGraph& sim = particle_system.updateGraph();
+        for (size_t i = 0; i < sim.size(); ++i)
+            SDL_Log("    %-24s start %7.3f ms  took %7.3f ms", sim.name(i).c_str(), sim.start_ms(i), sim.duration_ms(i));
+    }
+
+    const CullStats& cull = particle_system.cullStats();
+    SDL_Log("Cull: %zu visible, %zu culled, %zu merged into %zu LOD cells, %zu draw calls", cull.visible, cull.culled,
+            cull.merged, cull.lod_cells, particle_system.lastDrawCalls());
+
+    log_frame_pacing();
+}
+
+void State::log_frame_pacing() const
+{
+    const FrameTimeStats s = frame_pacer.stats();
+    SDL_Log("Frame time over %zu frames: mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f ms  (spin %.1f%%, sleep slack %.3f ms)",
+            s.frames, s.mean_ms, s.p50_ms, s.p90_ms, s.p99_ms, s.max_ms, s.spin_fraction * 100.0, frame_pacer.sleep_slack_ms());
+}
+
 void State::render()
 {
+    PROFILE_ZONE("State::render");
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
-    particle_system.render(renderer, camera);
+    if (threaded_simulation)
+    {
+        // Interpolate across the step that follows the snapshot, so drawing lags the simulation by one step
+        const ParticleSnapshot& snapshot = snapshots.read();
+        const double since = static_cast<double>(SDL_GetTicksNS() - std::min(snapshot.published_ns, SDL_GetTicksNS()));
+        const float alpha = static_cast<float>(std::min(since / (static_cast<double>(config.get_sim_step()) * 1e9), 1.0));
+        ViewParams view = ViewParams::from_config(config, camera, alpha);
+        view.textured = !software_rasterizer;
+        if (density_view) render_density(view, &snapshot);
+        else if (software_rasterizer) render_software(particle_system.buildGeometry(snapshot, view), view);
+        else particle_system.render(snapshot, *sdl_backend, view);
+    }
+    else
+    {
+        ViewParams view = ViewParams::from_config(config, camera, render_alpha);
+        view.textured = !software_rasterizer;
+        if (density_view) render_density(view, nullptr);
+        else if (software_rasterizer) render_software(particle_system.buildGeometry(view), view);
+        else particle_system.render(*sdl_backend, view);
+    }
 
     SDL_RenderPresent(renderer);
 }
 
+void State::render_software(const GeometryBatch& geometry, const ViewParams& view)
+{
+    software_rasterizer->draw(geometry, renderer, static_cast<int>(view.width), static_cast<int>(view.height));
+    particle_system.renderPlugins(*sdl_backend, view);
+}
+
+void State::render_density(const ViewParams& view, const ParticleSnapshot* snapshot)
+{
+    density_renderer.begin(view);
+    if (snapshot) { for (const auto& batch : snapshot->batches) density_renderer.accumulate(batch.store); }
+    else { for (size_t b = 0; b < particle_system.bucketCount(); ++b) density_renderer.accumulate(particle_system.bucketStore(b)); }
+    density_renderer.draw(renderer);
+    particle_system.renderPlugins(*sdl_backend, view);
+}
+
 void State::process_input()
 {
+    PROFILE_ZONE("State::process_input");
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -91,6 +241,8 @@ void State::process_input()
             if (event.key.key == SDLK_D) camera.x += panStepWorld;
             if (event.key.key == SDLK_W) camera.y -= panStepWorld;
             if (event.key.key == SDLK_S) camera.y += panStepWorld;
+            if (event.key.key == SDLK_H) density_view = !density_view; // toggle heatmap / per-particle rendering
+            if (event.key.key == SDLK_P) toggle_profiler();            // start recording / stop and write the trace
             break;
         }
     }
@@ -98,29 +250,52 @@ void State::process_input()
 
 void State::update()
 {
-    delay();
-    // Update particle simulation using the elapsed delta_time (seconds)
-    particle_system.update(delta_time);
-    last_frame_time = SDL_GetTicksNS();
+    PROFILE_ZONE("State::update");
+    // Consume the last frame's delta_time in fixed sim_step slices so results do not depend
+    // on frame jitter. Past max_sim_steps the backlog is dropped (the simulation slows
+    // down) rather than letting catch-up work grow every frame.
+    const float step = config.get_sim_step();
+    const int max_steps = std::max(config.get_max_sim_steps(), 1);
+    sim_accumulator += delta_time;
+    for (int steps = 0; sim_accumulator >= step && steps < max_steps; ++steps)
+    {
+        particle_system.update(SimParams::from_config(config, step));
+        sim_accumulator -= step;
+    }
+    if (sim_accumulator >= step) sim_accumulator = std::fmod(sim_accumulator, step);
+    render_alpha = sim_accumulator / step;
 }
 
 void State::delay()
 {
-    // Convert target frame delta (ms) to nanoseconds and compute end time
-    Uint64 frame_end_time = last_frame_time + static_cast<Uint64>(static_cast<double>(Config::get_instance().get_target_frame_delta()) * 1e6);
-    Uint64 current_time;
+    PROFILE_ZONE("State::delay");
+    // Sleep to the next frame deadline; delta_time is the whole frame period in seconds
+    delta_time = static_cast<float>(frame_pacer.wait());
+}
 
-    while ((current_time = SDL_GetTicksNS()) < frame_end_time)
+bool State::should_quit() const { return quit; }
+
+void State::toggle_profiler()
+{
+    Profiler& profiler = Profiler::get_instance();
+    if (Profiler::enabled())
     {
-        if (frame_end_time - current_time > 1000000ULL) { SDL_Delay(1); }
+        profiler.set_enabled(false);
+        write_profile();
+        return;
     }
-
-    // delta_time in seconds (nanoseconds -> seconds)
-    delta_time = static_cast<float>(static_cast<double>(current_time - last_frame_time) / 1e9);
-    last_frame_time = current_time;
+    profiler.clear();
+    profiler.set_enabled(true);
+    SDL_Log("Profiler recording (P again to stop and write %s)", config.get_profiler_output().c_str());
 }
 
-bool State::should_quit() const { return quit; }
+void State::write_profile() const
+{
+    const Profiler& profiler = Profiler::get_instance();
+    if (profiler.write_chrome_trace(config.get_profiler_output()))
+        SDL_Log("Profiler: wrote %zu zones to %s", profiler.zone_count(), config.get_profiler_output().c_str());
+    else SDL_Log("Profiler: cannot write %s", config.get_profiler_output().c_str());
+}
 
 void State::setup_scene()
 {
@@ -129,4 +304,11 @@ void State::setup_scene()
     // Center camera on world center by default.
     this->camera.x = 0.0f;
     this->camera.y = 0.0f;
+
+    // SpriteParticles draw frames of the configured atlas (flat squares if it fails to load)
+    if (!cfg.get_sprite_atlas().empty())
+    {
+        sprite_atlas = sdl_backend->load_atlas(cfg.get_sprite_atlas(), cfg.get_sprite_frame_width(), cfg.get_sprite_frame_height());
+        if (sprite_atlas) particle_system.setBucketAtlas(particle_system.registerType<SpriteParticle>(), sprite_atlas.get());
+    }
 }
\ No newline at end of file
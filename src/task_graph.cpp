@@ -0,0 +1,116 @@
+#include "task_graph.hpp"
+#include <chrono>
+#include "profiler.hpp"
+#include <thread>
+
+namespace
+{
+    int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+TaskGraph::StageId TaskGraph::add(std::string name, std::function<void()> fn, std::vector<StageId> deps, Affinity affinity)
+{
+    const StageId id = m_stages.size();
+    auto stage = std::make_unique<Stage>();
+    stage->name = std::move(name);
+    stage->profile_name = Profiler::get_instance().intern(stage->name);
+    stage->fn = std::move(fn);
+    stage->affinity = affinity;
+    stage->dependency_count = deps.size();
+    for (StageId dep : deps) m_stages[dep]->dependents.push_back(id);
+    m_stages.push_back(std::move(stage));
+    return id;
+}
+
+double TaskGraph::start_ms(StageId id) const
+{
+    return static_cast<double>(m_stages[id]->start_ns - m_run_start_ns) * 1e-6;
+}
+
+double TaskGraph::duration_ms(StageId id) const
+{
+    return static_cast<double>(m_stages[id]->end_ns - m_stages[id]->start_ns) * 1e-6;
+}
+
+void TaskGraph::run_stage_task(void* ctx, size_t id, size_t)
+{
+    static_cast<TaskGraph*>(ctx)->execute(id);
+}
+
+void TaskGraph::execute(StageId id)
+{
+    Stage& stage = *m_stages[id];
+    stage.start_ns = now_ns();
+    {
+        PROFILE_ZONE(stage.profile_name);
+        stage.fn();
+    }
+    stage.end_ns = now_ns();
+
+    for (StageId dependent : stage.dependents)
+        if (m_stages[dependent]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) schedule(dependent);
+    m_done.fetch_add(1, std::memory_order_release);
+}
+
+void TaskGraph::schedule(StageId id)
+{
+    Stage& stage = *m_stages[id];
+    if (stage.affinity == Affinity::Caller) stage.ready.store(true, std::memory_order_release);
+    else m_pool->submit(m_group, &TaskGraph::run_stage_task, this, id);
+}
+
+void TaskGraph::run(ThreadPool* pool)
+{
+    m_run_start_ns = now_ns();
+    const size_t n = m_stages.size();
+
+    if (!pool || pool->thread_count() == 1)
+    {
+        for (StageId id = 0; id < n; ++id)
+        {
+            Stage& stage = *m_stages[id];
+            stage.start_ns = now_ns();
+            {
+                PROFILE_ZONE(stage.profile_name);
+                stage.fn();
+            }
+            stage.end_ns = now_ns();
+        }
+        m_total_ns = now_ns() - m_run_start_ns;
+        return;
+    }
+
+    m_pool = pool;
+    m_done.store(0);
+    for (auto& stage : m_stages)
+    {
+        stage->remaining.store(stage->dependency_count, std::memory_order_relaxed);
+        stage->ready.store(false, std::memory_order_relaxed);
+        stage->started = false;
+    }
+    for (StageId id = 0; id < n; ++id)
+        if (m_stages[id]->dependency_count == 0) schedule(id);
+
+    // Run caller stages as they become ready; otherwise help the pool
+    while (m_done.load(std::memory_order_acquire) < n)
+    {
+        bool ran = false;
+        for (StageId id = 0; id < n; ++id)
+        {
+            Stage& stage = *m_stages[id];
+            if (stage.affinity != Affinity::Caller || stage.started || !stage.ready.load(std::memory_order_acquire)) continue;
+            stage.started = true;
+            execute(id);
+            ran = true;
+        }
+        if (!ran && !pool->help()) std::this_thread::yield();
+    }
+
+    // Stage tasks may still be returning from the pool
+    pool->wait(m_group);
+    m_pool = nullptr;
+    m_total_ns = now_ns() - m_run_start_ns;
+}
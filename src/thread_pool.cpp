@@ -0,0 +1,194 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "profiler.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#else
+#define CPU_RELAX() std::this_thread::yield()
+#endif
+
+namespace
+{
+    // How long an idle worker keeps polling before parking. Long enough to bridge
+    // the gaps between stages of one frame, short next to a 60 Hz frame budget.
+    constexpr auto kSpinDuration = std::chrono::microseconds(50);
+
+    constexpr size_t kNotWorker = static_cast<size_t>(-1);
+    thread_local size_t t_worker_index = kNotWorker;
+}
+
+bool ThreadPool::WorkQueue::push(const Task& task)
+{
+    std::lock_guard lock(mutex);
+    if (tail - head == kCapacity) return false;
+    ring[tail % kCapacity] = task;
+    ++tail;
+    return true;
+}
+
+bool ThreadPool::WorkQueue::pop_back(Task& task)
+{
+    std::lock_guard lock(mutex);
+    if (tail == head) return false;
+    --tail;
+    task = ring[tail % kCapacity];
+    return true;
+}
+
+bool ThreadPool::WorkQueue::steal(Task& task)
+{
+    std::lock_guard lock(mutex);
+    if (tail == head) return false;
+    task = ring[head % kCapacity];
+    ++head;
+    return true;
+}
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t workers = threads - 1;
+
+    m_queues.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) m_queues.push_back(std::make_unique<WorkQueue>());
+
+    m_workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) m_workers.emplace_back(&ThreadPool::worker_main, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    m_stop.store(true);
+    {
+        std::lock_guard lock(m_park_mutex);
+    }
+    m_park_cv.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void ThreadPool::run(TaskFn fn, void* ctx, size_t count, size_t grain)
+{
+    const size_t chunks = (count + grain - 1) / grain;
+    std::atomic<size_t> pending{chunks};
+
+    // Keep the first chunk for this thread; spread the rest over the worker queues
+    const size_t self = t_worker_index;
+    size_t queue = self != kNotWorker ? self : m_next_queue.fetch_add(1, std::memory_order_relaxed);
+    size_t queued = 0;
+    for (size_t c = 1; c < chunks; ++c)
+    {
+        Task task{ fn, ctx, c * grain, std::min(count, (c + 1) * grain), &pending };
+        if (m_queues[queue++ % m_queues.size()]->push(task)) ++queued;
+        else execute(task); // queue full: run inline
+    }
+    if (queued)
+    {
+        m_queued.fetch_add(queued);
+        wake_workers();
+    }
+
+    execute(Task{ fn, ctx, 0, std::min(count, grain), &pending });
+
+    // Help out until every chunk of this call has finished
+    Task task;
+    while (pending.load(std::memory_order_acquire) > 0)
+    {
+        if (try_take(self, task)) execute(task);
+        else CPU_RELAX();
+    }
+}
+
+void ThreadPool::submit(TaskGroup& group, TaskFn fn, void* ctx, size_t begin, size_t end)
+{
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    Task task{ fn, ctx, begin, end, &group.pending };
+
+    if (m_queues.empty()) { execute(task); return; }
+
+    const size_t self = t_worker_index;
+    const size_t queue = self != kNotWorker ? self : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    if (!m_queues[queue]->push(task)) { execute(task); return; }
+
+    m_queued.fetch_add(1);
+    wake_workers();
+}
+
+bool ThreadPool::help()
+{
+    Task task;
+    if (!try_take(t_worker_index, task)) return false;
+    execute(task);
+    return true;
+}
+
+void ThreadPool::wait(TaskGroup& group)
+{
+    while (group.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (!help()) CPU_RELAX();
+    }
+}
+
+bool ThreadPool::try_take(size_t self, Task& task)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0) return false;
+
+    const size_t n = m_queues.size();
+    bool found = false;
+    if (self != kNotWorker) found = m_queues[self]->pop_back(task);
+    for (size_t i = 1; !found && i <= n; ++i)
+    {
+        const size_t victim = self != kNotWorker ? (self + i) % n : i - 1;
+        found = m_queues[victim]->steal(task);
+    }
+    if (found) m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return found;
+}
+
+void ThreadPool::execute(const Task& task)
+{
+    task.fn(task.ctx, task.begin, task.end);
+    task.pending->fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::wake_workers()
+{
+    // m_queued was bumped (seq_cst) before reading m_parked, and workers bump
+    // m_parked before re-checking m_queued, so one side always sees the other.
+    if (m_parked.load() == 0) return;
+    {
+        std::lock_guard lock(m_park_mutex);
+    }
+    m_park_cv.notify_all();
+}
+
+void ThreadPool::worker_main(size_t index)
+{
+    t_worker_index = index;
+    PROFILE_THREAD("worker " + std::to_string(index));
+    Task task;
+    while (true)
+    {
+        if (try_take(index, task)) { execute(task); continue; }
+
+        // Spin briefly before parking
+        const auto spin_end = std::chrono::steady_clock::now() + kSpinDuration;
+        bool work = false;
+        while (std::chrono::steady_clock::now() < spin_end)
+        {
+            if (m_queued.load(std::memory_order_relaxed) > 0 || m_stop.load(std::memory_order_relaxed)) { work = true; break; }
+            CPU_RELAX();
+        }
+        if (m_stop.load() && m_queued.load() == 0) return;
+        if (work) continue;
+
+        std::unique_lock lock(m_park_mutex);
+        m_parked.fetch_add(1);
+        m_park_cv.wait(lock, [this] { return m_stop.load() || m_queued.load() > 0; });
+        m_parked.fetch_sub(1);
+    }
+}
@@ -0,0 +1,185 @@
+#include "test.hpp"
+#include <cstdint>
+#include <vector>
+#include "config.hpp"
+#include "particle_system.hpp"
+
+namespace
+{
+    struct OtherParticle : SimpleParticle
+    {
+        using SimpleParticle::SimpleParticle;
+    };
+
+    // Particle `id` carries id in every column, so survivors can be traced back
+    SimpleParticle tagged(size_t id)
+    {
+        const float v = static_cast<float>(id);
+        const uint8_t c = static_cast<uint8_t>(id);
+        return SimpleParticle(v, -v, v * 2.0f, v * 3.0f, 0.1f, Color{ c, c, c, 255 });
+    }
+
+    // Entry `index` of every column still describes particle `id`
+    bool holds(const ParticleStore& store, size_t index, size_t id)
+    {
+        const float v = static_cast<float>(id);
+        const uint8_t c = static_cast<uint8_t>(id);
+        return store.x[index] == v && store.y[index] == -v && store.prev_x[index] == v && store.prev_y[index] == -v &&
+               store.vx[index] == v * 2.0f && store.vy[index] == v * 3.0f && store.color[index].r == c;
+    }
+}
+
+// Buckets share one compaction scratch; the buffers it rotates through must keep
+// every bucket at full capacity, so refilling after removals never allocates
+TEST(shared_compaction_scratch_keeps_bucket_capacity)
+{
+    constexpr size_t kCount = 2000;
+    Config::get_instance().set_max_particles(static_cast<int>(kCount));
+    ParticleSystem ps;
+
+    const Color color{ 255, 255, 255, 255 };
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const float x = static_cast<float>(i);
+        if (i % 2) ps.addParticle(OtherParticle(x, 0.0f, 0.0f, 0.0f, 0.1f, color, i % 3 ? 0.0f : 0.01f));
+        else ps.addParticle(SimpleParticle(x, 0.0f, 0.0f, 0.0f, 0.1f, color, i % 3 ? 0.0f : 0.01f));
+    }
+    CHECK(ps.bucketCount() == 2);
+
+    ps.update(SimParams{ 0.02f });
+    const size_t expired = kCount - ps.count();
+    CHECK(expired == (kCount + 2) / 3);
+    CHECK(ps.killIf(1, [](ConstParticleSpan span, size_t i) { return span.x[i] < 500.0f; }) > 0);
+
+    // Survivors stay in spawn order
+    for (size_t b = 0; b < ps.bucketCount(); ++b)
+    {
+        const ParticleStore& store = ps.bucketStore(b);
+        for (size_t i = 1; i < store.size(); ++i) CHECK(store.x[i - 1] < store.x[i]);
+    }
+
+    ps.resetAllocatorStats();
+    size_t added = 0;
+    while (ps.count() < kCount)
+    {
+        const float x = static_cast<float>(kCount + added);
+        if (added++ % 2) ps.addParticle(OtherParticle(x, 0.0f, 0.0f, 0.0f, 0.1f, color));
+        else ps.addParticle(SimpleParticle(x, 0.0f, 0.0f, 0.0f, 0.1f, color));
+    }
+    CHECK(ps.allocatorStats().misses == 0);
+}
+
+// killParticle moves the last particle into the hole (all columns and its slot)
+TEST(kill_particle_swaps_last_into_place)
+{
+    Config::get_instance().set_max_particles(16);
+    ParticleSystem ps;
+    std::vector<ParticleHandle> handles;
+    for (size_t i = 0; i < 8; ++i) handles.push_back(ps.addParticle(tagged(i)));
+
+    ps.killParticle(0, 2);
+    const ParticleStore& store = ps.bucketStore(0);
+    CHECK(ps.count() == 7 && store.size() == 7);
+    CHECK(holds(store, 2, 7));
+    CHECK(store.slot[2] == handles[7].index);
+    CHECK(ps.find(handles[7]).index == 2);
+    for (size_t i : { 0, 1, 3, 4, 5, 6 }) CHECK(holds(store, i, i));
+
+    ps.killParticle(0, 6); // the last particle: nothing moves
+    CHECK(store.size() == 6);
+    for (size_t i : { 0, 1, 3, 4, 5 }) CHECK(holds(store, i, i) && ps.find(handles[i]).index == i);
+    CHECK(holds(store, 2, 7));
+
+    ps.killParticle(0, 6); // out of range: ignored
+    CHECK(ps.count() == 6);
+}
+
+// killIf compaction over several chunks, one of them emptied entirely, keeps the
+// survivors' columns together and in spawn order, and their handles resolving
+TEST(kill_if_keeps_survivor_columns_in_order)
+{
+    constexpr size_t kCount = 3 * kCompactionChunk + 17;
+    Config::get_instance().set_max_particles(static_cast<int>(kCount));
+    ParticleSystem ps;
+    std::vector<ParticleHandle> handles;
+    for (size_t i = 0; i < kCount; ++i) handles.push_back(ps.addParticle(tagged(i)));
+
+    const auto doomed = [](size_t id) { return id % 3 == 0 || (id >= kCompactionChunk && id < 2 * kCompactionChunk); };
+    const size_t removed = ps.killIf(0, [&](ConstParticleSpan span, size_t i) { return doomed(static_cast<size_t>(span.x[i])); });
+
+    std::vector<size_t> survivors;
+    for (size_t id = 0; id < kCount; ++id)
+        if (!doomed(id)) survivors.push_back(id);
+    CHECK(removed == kCount - survivors.size());
+    CHECK(ps.count() == survivors.size());
+
+    const ParticleStore& store = ps.bucketStore(0);
+    CHECK(store.size() == survivors.size());
+    for (size_t i = 0; i < survivors.size(); ++i)
+    {
+        const size_t id = survivors[i];
+        CHECK(holds(store, i, id));
+        CHECK(store.slot[i] == handles[id].index);
+        CHECK(ps.find(handles[id]).index == i);
+    }
+    for (size_t id = 0; id < kCount; ++id)
+        if (doomed(id)) CHECK(!ps.alive(handles[id]));
+}
+
+// A handle to a dead particle stays dead after its slot is reused
+TEST(stale_handle_after_slot_reuse)
+{
+    Config::get_instance().set_max_particles(16);
+    ParticleSystem ps;
+    const ParticleHandle old_handle = ps.addParticle(tagged(1));
+    CHECK(ps.killParticle(old_handle));
+
+    const ParticleHandle new_handle = ps.addParticle(tagged(2));
+    CHECK(new_handle.index == old_handle.index); // the freed slot is reused
+    CHECK(new_handle.generation != old_handle.generation);
+    CHECK(!ps.alive(old_handle));
+    CHECK(!ps.find(old_handle));
+
+    const ParticleRef ref = ps.find(new_handle);
+    CHECK(ps.alive(new_handle) && ref && ref.store->x[ref.index] == 2.0f);
+}
+
+// Handles follow their particle when a kill or a compaction changes its dense index
+TEST(handle_follows_moved_particle)
+{
+    Config::get_instance().set_max_particles(16);
+    ParticleSystem ps;
+    std::vector<ParticleHandle> handles;
+    for (size_t i = 0; i < 8; ++i) handles.push_back(ps.addParticle(tagged(i)));
+
+    CHECK(ps.killParticle(handles[0])); // swap-and-pop: 7 moves to index 0
+    ParticleRef ref = ps.find(handles[7]);
+    CHECK(ref && ref.index == 0 && holds(*ref.store, ref.index, 7));
+
+    // Order is now 7 1 2 3 4 5 6; removing 1..4 compacts 5 and 6 down to 1 and 2
+    CHECK(ps.killIf([](ConstParticleSpan span, size_t i) { return span.x[i] >= 1.0f && span.x[i] <= 4.0f; }) == 4);
+    for (size_t id : { 7, 5, 6 })
+    {
+        ref = ps.find(handles[id]);
+        CHECK(ref && holds(*ref.store, ref.index, id));
+    }
+    CHECK(ps.find(handles[5]).index == 1 && ps.find(handles[6]).index == 2);
+}
+
+// Killing through the same handle twice removes one particle; the second call
+// must not hit whatever reused the slot
+TEST(double_kill_through_handle)
+{
+    Config::get_instance().set_max_particles(16);
+    ParticleSystem ps;
+    const ParticleHandle a = ps.addParticle(tagged(1));
+    const ParticleHandle b = ps.addParticle(tagged(2));
+
+    CHECK(ps.killParticle(a));
+    CHECK(!ps.killParticle(a));
+    CHECK(ps.count() == 1 && ps.alive(b));
+
+    const ParticleHandle c = ps.addParticle(tagged(3)); // reuses a's slot
+    CHECK(!ps.killParticle(a));
+    CHECK(ps.count() == 2 && ps.alive(b) && ps.alive(c));
+}
@@ -0,0 +1,142 @@
+#include "test.hpp"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "simd_kernels.hpp"
+
+namespace
+{
+    using IntegrateFn = void (*)(float*, float*, float*, float*, size_t, const IntegrateParams&);
+    using CullFn = size_t (*)(const float*, const float*, const float*, const float*, const float*,
+                              size_t, const CullParams&, uint32_t, uint32_t*);
+
+    struct Variant
+    {
+        SimdLevel level;
+        IntegrateFn integrate;
+        CullFn cull;
+    };
+
+    constexpr Variant kVectorVariants[] = {
+        { SimdLevel::SSE2, &integrate_sse2, &cull_sse2 },
+        { SimdLevel::AVX2, &integrate_avx2, &cull_avx2 },
+        { SimdLevel::AVX512, &integrate_avx512, &cull_avx512 },
+    };
+
+    // Not a multiple of any vector width, so every variant also runs its tail path
+    constexpr size_t kCount = 1037;
+
+    struct Columns
+    {
+        std::vector<float> x, y, vx, vy, prev_x, prev_y, radius;
+
+        explicit Columns(uint32_t seed)
+        {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> pos(-100.0f, 100.0f), vel(-5.0f, 5.0f), rad(0.01f, 0.5f);
+            for (size_t i = 0; i < kCount; ++i)
+            {
+                x.push_back(pos(rng)); y.push_back(pos(rng));
+                vx.push_back(vel(rng)); vy.push_back(vel(rng));
+                prev_x.push_back(x.back() - vx.back() * 0.1f); prev_y.push_back(y.back() - vy.back() * 0.1f);
+                radius.push_back(rad(rng));
+            }
+        }
+    };
+
+    bool bitwise_equal(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    bool available(SimdLevel level) { return static_cast<int>(level) <= static_cast<int>(detect_simd_level()); }
+}
+
+// Documented tolerance: with -ffp-contract=off the vector paths match scalar bit for bit
+TEST(integrate_variants_match_scalar_bitwise)
+{
+    const IntegrateParams params = IntegrateParams::make(0.3f, 9.8f, 0.5f, 1.0f / 60.0f);
+    Columns expected(1);
+    for (int step = 0; step < 8; ++step)
+        integrate_scalar(expected.x.data(), expected.y.data(), expected.vx.data(), expected.vy.data(), kCount, params);
+
+    for (const Variant& variant : kVectorVariants)
+    {
+        if (!available(variant.level)) { report_skip(simd_level_name(variant.level)); continue; }
+        Columns actual(1);
+        for (int step = 0; step < 8; ++step)
+            variant.integrate(actual.x.data(), actual.y.data(), actual.vx.data(), actual.vy.data(), kCount, params);
+        CHECK(bitwise_equal(actual.x, expected.x));
+        CHECK(bitwise_equal(actual.y, expected.y));
+        CHECK(bitwise_equal(actual.vx, expected.vx));
+        CHECK(bitwise_equal(actual.vy, expected.vy));
+    }
+}
+
+TEST(cull_variants_match_scalar)
+{
+    const Columns c(2);
+    const CullParams params{ -20.0f, 30.0f, -40.0f, 10.0f, 0.5f };
+    constexpr uint32_t kBase = 7;
+    std::vector<uint32_t> expected(kCount);
+    const size_t expected_count = cull_scalar(c.x.data(), c.y.data(), c.prev_x.data(), c.prev_y.data(), c.radius.data(),
+                                              kCount, params, kBase, expected.data());
+    expected.resize(expected_count);
+    CHECK(expected_count > 0 && expected_count < kCount);
+
+    for (const Variant& variant : kVectorVariants)
+    {
+        if (!available(variant.level)) { report_skip(simd_level_name(variant.level)); continue; }
+        std::vector<uint32_t> actual(kCount);
+        actual.resize(variant.cull(c.x.data(), c.y.data(), c.prev_x.data(), c.prev_y.data(), c.radius.data(),
+                                   kCount, params, kBase, actual.data()));
+        CHECK(actual == expected);
+    }
+}
+
+TEST(configure_selects_supported_variants)
+{
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+    {
+        if (!available(level)) continue;
+        std::string warning;
+        CHECK(configure_simd_kernels(simd_level_name(level), warning) == level);
+        CHECK(warning.empty());
+        CHECK(active_simd_level() == level);
+    }
+    std::string warning = "stale";
+    CHECK(configure_simd_kernels("auto", warning) == detect_simd_level());
+    CHECK(warning.empty());
+}
+
+// Forcing a variant the CPU lacks must fall back (and say so) rather than raise SIGILL
+TEST(configure_falls_back_from_unsupported_variant)
+{
+    const SimdLevel detected = detect_simd_level();
+    const IntegrateParams params = IntegrateParams::make(0.3f, 9.8f, 0.5f, 1.0f / 60.0f);
+    Columns expected(3);
+    integrate_scalar(expected.x.data(), expected.y.data(), expected.vx.data(), expected.vy.data(), kCount, params);
+
+    bool tested = false;
+    for (const Variant& variant : kVectorVariants)
+    {
+        if (available(variant.level)) continue;
+        tested = true;
+        std::string warning;
+        CHECK(configure_simd_kernels(simd_level_name(variant.level), warning) == detected);
+        CHECK(active_simd_level() == detected);
+        CHECK(warning.find("not supported") != std::string::npos);
+
+        Columns actual(3);
+        integrate(actual.x.data(), actual.y.data(), actual.vx.data(), actual.vy.data(), kCount, params);
+        CHECK(bitwise_equal(actual.x, expected.x) && bitwise_equal(actual.vy, expected.vy));
+    }
+    if (!tested) report_skip("this CPU supports every variant");
+
+    std::string warning;
+    CHECK(configure_simd_kernels("avx1024", warning) == detected);
+    CHECK(warning.find("Unknown simd_kernel 'avx1024'") != std::string::npos);
+
+    configure_simd_kernels("auto", warning);
+}
@@ -0,0 +1,75 @@
+#include "test.hpp"
+#include <cstring>
+#include <random>
+#include <vector>
+#include "config.hpp"
+#include "particle_system.hpp"
+#include "static_particle_system.hpp"
+
+namespace
+{
+    // Keeps every submitted vertex instead of drawing it
+    class CaptureBackend : public RenderBackend
+    {
+    public:
+        void draw_quads(const Vertex* vertices, size_t quads, TextureId) override
+        {
+            this->vertices.insert(this->vertices.end(), vertices, vertices + quads * 4);
+        }
+        void fill_rect(float, float, float, float, Color) override {}
+
+        std::vector<Vertex> vertices;
+    };
+
+    template <typename T>
+    bool bitwise_equal(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+    }
+}
+
+// The statically dispatched system must simulate and draw exactly what ParticleSystem does
+TEST(static_system_matches_particle_system)
+{
+    constexpr size_t kCount = 5000;
+    Config& config = Config::get_instance();
+    config.set_max_particles(static_cast<int>(kCount));
+
+    ParticleSystem dynamic_system;
+    StaticParticleSystem<SimpleParticle> static_system;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> pos(-12.0f, 12.0f), vel(-3.0f, 3.0f), life(0.05f, 1.0f);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        // Every other particle expires during the run, so compaction is compared too
+        const SimpleParticle p(pos(rng), pos(rng), vel(rng), vel(rng), 0.1f, Color{ 200, 100, 50, 255 }, i % 2 ? life(rng) : 0.0f);
+        dynamic_system.addParticle(p);
+        static_system.addParticle(p);
+    }
+
+    const SimParams params{ 1.0f / 60.0f, 0.5f, 2.0f, 0.3f };
+    for (int step = 0; step < 30; ++step)
+    {
+        dynamic_system.update(params);
+        static_system.update(params);
+    }
+
+    const ParticleStore& expected = dynamic_system.bucketStore(0);
+    const ParticleStore& actual = static_system.storeOf<SimpleParticle>();
+    CHECK(actual.size() == expected.size());
+    CHECK(actual.size() < kCount);
+    CHECK(bitwise_equal(actual.x, expected.x));
+    CHECK(bitwise_equal(actual.y, expected.y));
+    CHECK(bitwise_equal(actual.vx, expected.vx));
+    CHECK(bitwise_equal(actual.vy, expected.vy));
+    CHECK(bitwise_equal(actual.age, expected.age));
+
+    ViewParams view = ViewParams::from_config(config, SimpleCamera{}, 0.5f);
+    view.lod_threshold_px = 0.0f;
+    CaptureBackend dynamic_out, static_out;
+    dynamic_system.render(dynamic_out, view);
+    static_system.render(static_out, view);
+    CHECK(!static_out.vertices.empty());
+    CHECK(bitwise_equal(static_out.vertices, dynamic_out.vertices));
+    CHECK(static_system.cullStats().visible == dynamic_system.cullStats().visible);
+}
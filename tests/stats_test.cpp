@@ -0,0 +1,54 @@
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "bench.hpp"
+#include "stats.hpp"
+
+namespace
+{
+    std::string write_report(const std::string& file, const nlohmann::json& benchmarks)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / file).string();
+        std::ofstream(path) << nlohmann::json{ { "benchmarks", benchmarks } }.dump();
+        return path;
+    }
+
+    nlohmann::json series(const std::string& name, std::vector<double> samples)
+    {
+        return { { "name", name }, { "particles", 1000 }, { "samples", samples } };
+    }
+}
+
+TEST(compare_samples_relative_verdicts)
+{
+    const std::vector<double> base{ 10.0, 10.1, 9.9, 10.0, 10.0 };
+    CHECK(compare_samples(base, { 12.0, 12.1, 11.9, 12.0, 12.0 }, 0.05).verdict == Comparison::Verdict::Regression);
+    CHECK(compare_samples(base, { 8.0, 8.1, 7.9, 8.0, 8.0 }, 0.05).verdict == Comparison::Verdict::Improvement);
+    CHECK(compare_samples(base, { 10.1, 10.0, 9.9, 10.0, 10.1 }, 0.05).verdict == Comparison::Verdict::Unchanged);
+    CHECK(compare_samples(base, { 12.0 }, 0.05).verdict == Comparison::Verdict::Inconclusive);
+}
+
+// A well-paced baseline has zero overshoot; a run that overshoots must still fail
+TEST(compare_samples_zero_baseline)
+{
+    const std::vector<double> zero{ 0.0, 0.0, 0.0, 0.0, 0.0 };
+    CHECK(compare_samples(zero, { 0.4, 0.5, 0.6, 0.5, 0.5 }, 0.05).verdict == Comparison::Verdict::Regression);
+    CHECK(compare_samples(zero, { 0.5, 0.5, 0.5, 0.5, 0.5 }, 0.05).verdict == Comparison::Verdict::Regression);
+    CHECK(compare_samples(zero, zero, 0.05).verdict == Comparison::Verdict::Unchanged);
+    // One noisy trial out of five is not a reliable overshoot
+    CHECK(compare_samples(zero, { 0.0, 0.0, 0.0, 0.0, 2.0 }, 0.05).verdict == Comparison::Verdict::Unchanged);
+}
+
+TEST(compare_reports_fails_on_missing_benchmark)
+{
+    const nlohmann::json update = series("update", { 10.0, 10.1, 9.9 });
+    const std::string base = write_report("particulate_test_base.json", nlohmann::json::array({ update, series("frame", { 50.0, 51.0, 49.0 }) }));
+    const std::string same = write_report("particulate_test_same.json", nlohmann::json::array({ update, series("frame", { 50.0, 51.0, 49.0 }) }));
+    const std::string partial = write_report("particulate_test_partial.json", nlohmann::json::array({ update }));
+    CHECK(compare_reports(base, same, 0.05, ""));
+    CHECK(!compare_reports(base, partial, 0.05, ""));
+    // Benchmarks only the current run has are not a failure
+    CHECK(compare_reports(partial, base, 0.05, ""));
+    for (const std::string& path : { base, same, partial }) std::filesystem::remove(path);
+}
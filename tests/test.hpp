@@ -0,0 +1,29 @@
+#ifndef TEST_HPP
+#define TEST_HPP
+
+#include <cstdio>
+#include <vector>
+
+// Minimal self-registering test harness for particulate_tests: every TEST in
+// tests/*.cpp runs once from test_main.cpp, a failed CHECK prints its location
+// and marks the run failed without stopping the test.
+struct TestCase
+{
+    const char* name;
+    void (*fn)();
+};
+
+std::vector<TestCase>& test_registry();
+bool register_test(const char* name, void (*fn)());
+void report_failure(const char* file, int line, const char* expr);
+// Note that the rest of a test was skipped (e.g. an instruction set this CPU lacks).
+void report_skip(const char* what);
+
+#define TEST(name) \
+    static void name(); \
+    [[maybe_unused]] static const bool name##_registered = register_test(#name, &name); \
+    static void name()
+
+#define CHECK(expr) do { if (!(expr)) report_failure(__FILE__, __LINE__, #expr); } while (0)
+
+#endif
@@ -0,0 +1,42 @@
+#include "test.hpp"
+
+namespace
+{
+    int g_failures = 0;
+}
+
+std::vector<TestCase>& test_registry()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+bool register_test(const char* name, void (*fn)())
+{
+    test_registry().push_back({ name, fn });
+    return true;
+}
+
+void report_failure(const char* file, int line, const char* expr)
+{
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    ++g_failures;
+}
+
+void report_skip(const char* what)
+{
+    std::printf("  skipped: %s\n", what);
+}
+
+int main()
+{
+    for (const TestCase& test : test_registry())
+    {
+        const int before = g_failures;
+        std::printf("%s\n", test.name);
+        test.fn();
+        if (g_failures != before) std::printf("  FAILED\n");
+    }
+    std::printf("%zu tests, %d failed checks\n", test_registry().size(), g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
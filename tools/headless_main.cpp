@@ -0,0 +1,20 @@
+#include <headless.hpp>
+#include <iostream>
+
+// Headless-only build of the simulation: links particulate_core alone, so it runs
+// on machines without SDL or a display. Reads config.json like the app.
+int main()
+{
+    try
+    {
+        HeadlessRunner runner(Config::get_instance());
+        runner.run();
+        return EXIT_SUCCESS;
+    }
+
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Fatal error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}